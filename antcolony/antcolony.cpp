@@ -1,103 +1,70 @@
 #include <iostream>
 #include <vector>
 #include <string>
-#include <set>
 #include <chrono>
-#include <cstdarg>
 #include <cstdio>
 #include <algorithm>
-#include <random>
-#include <tuple>
 
-#include "ant_colony_optimization.h"
+#include "../solvers/ant_colony_solver.h"
+#include "../solvers/core_reduction.h"
+#include "../solvers/improvement_trace.h"
+#include "../solvers/instance_io.h"
 
-namespace
+int main(int argc, char* argv[])
 {
-    using ACO = AntColonyKnapsackOptimization;
-    
-
-    ACO::Items loadItems(const std::string& filepath, int& Cap, int& Profit)
-    {
-        ACO::Items items;
-        // load items from file
-        FILE* in = fopen(filepath.c_str(), "r");
-        if (in != NULL)
-        {
-            int len = 0;
-            char d1, d2;
-            fscanf(in, "%d %c %c\n", &len, &d1, &d2);
-
-            for (int i = 0; i < len; i++)
-            {
-                int n = 0;
-                int x = 0;
-                int c = 0;
-                int w = 0;
-                fscanf(in, "%d %d %d %d\n", &n, &c, &w, &x);
-
-                items.push_back(ACO::Item(c, w));
-            }
-
-            fscanf(in, "%d\n", &Cap);
-            fscanf(in, "%d\n", &Profit);
-
-            fclose(in);
-        }
-
-        return items;
-    }
+    int numStarts = 10;
+    if (argc >= 2)
+        numStarts = atoi(argv[1]);
 
-    void saveItems(const std::string& filepath, const ACO::Items& items, int cap, int cost)
-    {
-        FILE* out = fopen(filepath.c_str(), "w");
-        if (out != NULL)
-        {
-            fprintf(out, "%5llu     C     W\n", items.size());
-            for (int i = 0; i < items.size(); ++i)
-            {
-                fprintf(out, "%5d %5d %5d %5d\n", i, items[i].c, items[i].w, items[i].x);
-            }
-            fprintf(out, "%d\n", cap);
-            fprintf(out, "%d\n", cost);
-            fclose(out);
-        }
-    }
+    int antsPerGeneration = 1;
+    if (argc >= 3)
+        antsPerGeneration = atoi(argv[2]);
 
-    bool spam = true;
-    void log(FILE* f, const char* format, ...)
-    {
-        va_list args;
-        va_start(args, format);
+    int numThreads = 1;
+    if (argc >= 4)
+        numThreads = atoi(argv[3]);
 
+    unsigned long long seed = time(NULL);
+    if (argc >= 5)
+        seed = strtoull(argv[4], NULL, 10);
 
-        char buffer[1024];
-        vsnprintf(buffer, sizeof(buffer), format, args);
+    // 0 - dense matrix, 1 - per item trail, 2 - sparse edges
+    int pheromoneModel = 0;
+    if (argc >= 6)
+        pheromoneModel = atoi(argv[5]);
 
-        if( spam )
-            printf("%s", buffer);
-        fprintf(f, "%s", buffer);
+    // test.out layout, or a binary .kbin file
+    std::string input = "test.out";
+    if (argc >= 7)
+        input = argv[6];
 
-        fflush(f);
-        va_end(args);
-    }
-}
-
-int main(int argc, char* argv[])
-{
-    int numStarts = 10;
-    if (argc >= 2)
-        numStarts = atoi(argv[1]);
+    // 1 - search only the core left by fixing items with reduced costs
+    bool core = false;
+    if (argc >= 8)
+        core = atoi(argv[7]) != 0;
 
     int Cap = 0;
     int Profit = 0;
-    auto items = loadItems("test.out", Cap, Profit);
+    KnapsackInstance items = loadItems(input, Cap, Profit);
+
+    // every pass stops once it reaches the bound
+    const long long upperBound = dantzigBound(items, Cap);
 
     FILE* logfile = fopen("results/log.txt", "w");
     FILE* deviation = fopen("results/deviation.txt", "w");
+    // the cost of every ant, fully buffered and without the log lock so
+    // that the colony doesn't flush on every ant
     FILE* fx = fopen("results/fx.txt", "w");
+    if (fx != NULL)
+        setvbuf(fx, NULL, _IOFBF, 1 << 20);
+
+    // improvements of every pass, see improvement_trace.h
+    ImprovementTrace trace("results/trace.tsv", upperBound);
 
-    log(logfile, "Benchmark data: Num items = %llu, Cap = %d, Profit = %d\n", items.size(), Cap, Profit);
-    log(logfile, "NumStarts = %d\n", numStarts);
+    log(logfile, "Benchmark data: Num items = %llu, Cap = %d, Profit = %d, Dantzig bound = %lld\n",
+        items.size(), Cap, Profit, upperBound);
+    log(logfile, "NumStarts = %d, AntsPerGeneration = %d, NumThreads = %d, Seed = %llu, PheromoneModel = %d, Core = %d\n",
+        numStarts, antsPerGeneration, numThreads, seed, pheromoneModel, int(core));
 
     auto timeStart = std::chrono::system_clock::now();
 
@@ -105,14 +72,21 @@ int main(int argc, char* argv[])
     int worstProfit = -1;
     int globalIteration = 0;
 
-    ACO alg(0.5, 2.5, 0.9);
+    std::unique_ptr<Solver> solver = std::make_unique<AntColonySolver>(
+        AntColonySolver::PheromoneModel(pheromoneModel), antsPerGeneration);
+    if (core)
+        solver = std::make_unique<CoreSolver>(std::move(solver));
 
-    alg.setFxLogger([&](const std::string& msg)
-        {
-            spam = false;
-            log(fx, "%d\t%s\n", globalIteration++, msg.c_str());
-            spam = true;
-        });
+    SolverOptions options;
+    options.seed = seed;
+    options.numThreads = numThreads;
+    options.upperBound = upperBound;
+    options.onStep = [&](const SolverEvent& e)
+    {
+        if (fx != NULL)
+            fprintf(fx, "%d\t%lld\n", globalIteration, e.profit);
+        ++globalIteration;
+    };
 
     for (int i = 0; i < numStarts; ++i)
     {
@@ -120,14 +94,18 @@ int main(int argc, char* argv[])
 
         std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
 
-        alg.setItems(items, Cap);
-        alg.run(700);
+        options.stream = i;
+        options.onImprove = trace.callback(i);
+        SolverResult result = solver->solve(items, Cap, options);
 
-        auto profit = alg.getProfit();
+        const int profit = int(result.profit);
+        if (result.stats.coreSize > 0)
+            log(logfile, "The core has %lld of %llu items\n", result.stats.coreSize, items.size());
 
         std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
-        log(logfile, "Pass %d finished in %llu seconds\n", i, std::chrono::duration_cast<std::chrono::seconds>(end - begin).count());
-        log(logfile, "The deviation from ideal value = %d\n", Profit - profit);
+        log(logfile, "Pass %d finished in %.3f seconds\n", i, std::chrono::duration<double>(end - begin).count());
+        log(logfile, "The deviation from ideal value = %d, the gap to the bound = %s%s\n",
+            Profit - profit, gapText(upperBound, profit).c_str(), result.stats.optimal ? ", optimal" : "");
         log(logfile, "===================================\n");
 
         fprintf(deviation, "%d\t%f\n", profit, double(Profit - profit) / double( Profit ) );
@@ -135,7 +113,7 @@ int main(int argc, char* argv[])
 
         std::string filename = "results/testMy" + std::to_string(i) + ".out";
 
-        saveItems(filename, alg.getItems(), Cap, profit);
+        saveItems(filename, items, result.x, Cap, profit);
 
         if( worstProfit < 0 )
             worstProfit = profit;
@@ -146,6 +124,9 @@ int main(int argc, char* argv[])
             worstProfit = profit;
     }
 
+    if (trace.dropped() > 0)
+        log(logfile, "%lld trace records were dropped\n", trace.dropped());
+
     auto timeStop = std::chrono::system_clock::now();
 
     log(logfile, "%d passes finished in %llu minutes\n",
@@ -0,0 +1,321 @@
+// Benchmark of all the solvers over a fixed matrix of gen2 instances:
+//
+//   benchmark [-o results] [-d dir] [-g gen2] [-t seconds] [-n maxItems]
+//             [-s seed] [-j threads] [-p gap]
+//
+// Every gen2 type is generated with 10^2 .. 10^7 items (up to maxItems)
+// and with the capacities of gen2 instances 1, 2 and 3 of a series of 4,
+// i.e. 20%, 40% and 60% of the total weight. The coefficient range is
+// 1000, lowered for the large sizes so that sums of profits fit in int.
+// Instances are written to dir ("instances" by default) as .kbin files
+// and reused by later runs, gen2 is taken from the directory of the
+// benchmark unless given.
+//
+// minknap solves every instance first, its optimum is the target of the
+// heuristics hc, hc-vnd, hc-repair, ts, ts-repair and aco (item pheromone,
+// the dense matrix doesn't scale) and of minknap-warm, minknap started from
+// a short ts-repair run. They run with the fixed seed and a budget of
+// seconds each (10 by default). Every run is made in a child process, so its peak memory
+// is measured on its own and a crash is recorded instead of ending the
+// benchmark. One tab separated line per run is written to results
+// ("benchmark.tsv" by default):
+//
+//   type  n  capacity  Cap  solver  seed  profit  optimum  gap
+//   target_ms  seconds  iterations  evaluations  peak_kb  status
+//
+// gap is (optimum - profit) / optimum, target_ms is the time until the
+// profit was within the target gap (-p, 0 by default) of the optimum or
+// -1 if it never was. status is ok, failed, or skipped for instances whose
+// values don't fit the solvers' int arithmetic. A run fails when it crashes
+// or when its solution doesn't check out against the instance: the profit
+// or weight it reports is wrong, the weight exceeds Cap or the profit is
+// above the optimum.
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../solvers/solver.h"
+#include "../solvers/ant_colony_solver.h"
+#include "../solvers/instance_io.h"
+
+namespace
+{
+    const int Types[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 11, 12, 13, 14, 15 };
+    const long long Sizes[] = { 100, 1000, 10000, 100000, 1000000, 10000000 };
+    const int Capacities[] = { 1, 2, 3 };
+    const int Series = 4;
+    const int Range = 1000;
+
+    struct Options
+    {
+        std::string results = "benchmark.tsv";
+        std::string dir = "instances";
+        std::string gen2;
+        double seconds = 10;
+        long long maxItems = 10000000;
+        unsigned long long seed = 1;
+        int numThreads = 1;
+        double targetGap = 0;
+    };
+
+    enum Status { Ok, Failed, Skipped };
+    const char* StatusNames[] = { "ok", "failed", "skipped" };
+
+    // outcome of one run, passed from the child process through a pipe
+    struct Run
+    {
+        Status status;
+        long long profit;
+        long long iterations;
+        long long evaluations;
+        double seconds;
+        double targetMs;
+        long peakKb;
+    };
+
+    // the coefficients of gen2 are int, its Avis capacities overflow above 1000 items
+    int rangeFor(int type, long long n)
+    {
+        if ((type == 11 || type == 12) && n > 1000)
+            return 0;
+        return int(std::min<long long>(Range, 1000000000LL / n));
+    }
+
+    bool fileExists(const std::string& path)
+    {
+        struct stat st;
+        return stat(path.c_str(), &st) == 0;
+    }
+
+    bool generate(const Options& o, int type, long long n, int capacity, const std::string& path)
+    {
+        if (fileExists(path))
+            return true;
+        const std::string command = o.gen2 + " " + std::to_string(n) + " " + std::to_string(rangeFor(type, n)) +
+            " " + std::to_string(type) + " " + std::to_string(capacity) + " " + std::to_string(Series) +
+            " " + path + " > /dev/null";
+        return std::system(command.c_str()) == 0 && fileExists(path);
+    }
+
+    // the solvers keep profits and weights of solutions in int
+    bool fitsInt(const KnapsackInstance& items, int Cap)
+    {
+        if (items.size() == 0 || Cap <= 0)
+            return false;
+        long long P = 0;
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            if (items.c[i] <= 0 || items.w[i] <= 0)
+                return false;
+            P += items.c[i];
+        }
+        return P <= INT_MAX;
+    }
+
+    // optimum is -1 when it isn't known
+    Run solve(const Solver& solver, const KnapsackInstance& items, int Cap, SolverOptions options, long long target,
+        long long optimum)
+    {
+        Run run = { Failed, 0, 0, 0, 0, -1, 0 };
+        const auto start = std::chrono::steady_clock::now();
+        std::mutex mutex;
+        options.onImprove = [&](const SolverEvent& e)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (run.targetMs < 0 && target >= 0 && e.profit >= target)
+                run.targetMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        SolverResult result = solver.solve(items, Cap, options);
+        long long W = 0;
+        long long P = 0;
+        const bool complete = result.x.size() == items.size();
+        if (complete)
+            items.evaluate(result.x, W, P);
+        const bool valid = complete && P == result.profit && W == result.weight && W <= Cap &&
+            (optimum < 0 || P <= optimum);
+        run.status = valid ? Ok : Failed;
+        run.profit = result.profit;
+        run.iterations = result.stats.iterations;
+        run.evaluations = result.stats.evaluations;
+        run.seconds = result.stats.seconds;
+        return run;
+    }
+
+    // runs the solver in a child process, which reports back through a pipe
+    Run solveIsolated(const Solver& solver, const KnapsackInstance& items, int Cap,
+        const SolverOptions& options, long long target, long long optimum)
+    {
+        Run run = { Failed, 0, 0, 0, 0, -1, 0 };
+        int fds[2];
+        if (pipe(fds) != 0)
+            return run;
+
+        fflush(NULL);
+        const pid_t pid = fork();
+        if (pid == 0)
+        {
+            close(fds[0]);
+            try
+            {
+                run = solve(solver, items, Cap, options, target, optimum);
+            }
+            catch (...)
+            {
+                run.status = Failed;
+            }
+            const bool written = write(fds[1], &run, sizeof(run)) == sizeof(run);
+            _exit(written ? 0 : 1);
+        }
+
+        close(fds[1]);
+        const bool received = pid > 0 && read(fds[0], &run, sizeof(run)) == sizeof(run);
+        close(fds[0]);
+
+        int wstatus = 0;
+        struct rusage usage;
+        memset(&usage, 0, sizeof(usage));
+        if (pid > 0)
+            wait4(pid, &wstatus, 0, &usage);
+        if (!received || !WIFEXITED(wstatus) || WEXITSTATUS(wstatus) != 0)
+            run.status = Failed;
+        run.peakKb = usage.ru_maxrss;
+        return run;
+    }
+
+    void report(FILE* out, int type, long long n, int capacity, int Cap, const char* solver,
+        const Options& o, const Run& run, long long optimum)
+    {
+        const double gap = run.status == Ok && optimum > 0 ? double(optimum - run.profit) / double(optimum) : -1;
+        const char* format = "%d\t%lld\t%d\t%d\t%s\t%llu\t%lld\t%lld\t%.6f\t%.3f\t%.3f\t%lld\t%lld\t%ld\t%s\n";
+        fprintf(out, format, type, n, capacity, Cap, solver, o.seed, run.profit, optimum, gap,
+            run.targetMs, run.seconds, run.iterations, run.evaluations, run.peakKb, StatusNames[run.status]);
+        fflush(out);
+        printf(format, type, n, capacity, Cap, solver, o.seed, run.profit, optimum, gap,
+            run.targetMs, run.seconds, run.iterations, run.evaluations, run.peakKb, StatusNames[run.status]);
+    }
+
+    bool parseOptions(int argc, char* argv[], Options& o)
+    {
+        for (int i = 1; i + 1 < argc; i += 2)
+        {
+            const std::string flag = argv[i];
+            const char* value = argv[i + 1];
+            if (flag == "-o") o.results = value;
+            else if (flag == "-d") o.dir = value;
+            else if (flag == "-g") o.gen2 = value;
+            else if (flag == "-t") o.seconds = atof(value);
+            else if (flag == "-n") o.maxItems = strtoll(value, NULL, 10);
+            else if (flag == "-s") o.seed = strtoull(value, NULL, 10);
+            else if (flag == "-j") o.numThreads = std::max(1, atoi(value));
+            else if (flag == "-p") o.targetGap = atof(value);
+            else return false;
+        }
+        if (argc % 2 == 0)
+            return false;
+
+        if (o.gen2.empty())
+        {
+            const std::string self = argv[0];
+            const size_t slash = self.rfind('/');
+            o.gen2 = slash == std::string::npos ? "gen2" : self.substr(0, slash + 1) + "gen2";
+        }
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options o;
+    if (!parseOptions(argc, argv, o))
+    {
+        printf("usage: benchmark [-o results] [-d dir] [-g gen2] [-t seconds] [-n maxItems] "
+            "[-s seed] [-j threads] [-p gap]\n");
+        return 1;
+    }
+
+    mkdir(o.dir.c_str(), 0755);
+    FILE* out = fopen(o.results.c_str(), "w");
+    if (out == NULL)
+    {
+        printf("cannot open %s\n", o.results.c_str());
+        return 1;
+    }
+    fprintf(out, "type\tn\tcapacity\tCap\tsolver\tseed\tprofit\toptimum\tgap\t"
+        "target_ms\tseconds\titerations\tevaluations\tpeak_kb\tstatus\n");
+
+    const std::unique_ptr<Solver> exact = createSolver("minknap");
+    std::vector<std::unique_ptr<Solver>> heuristics;
+    for (const char* name : { "hc", "hc-vnd", "hc-repair", "ts", "ts-repair", "minknap-warm" })
+        heuristics.push_back(createSolver(name));
+    heuristics.push_back(std::make_unique<AntColonySolver>(AntColonySolver::PheromoneModel::Item));
+
+    SolverOptions options;
+    options.timeLimit = o.seconds;
+    options.seed = o.seed;
+    options.numThreads = o.numThreads;
+
+    int failed = 0;
+    for (long long n : Sizes)
+    {
+        if (n > o.maxItems)
+            break;
+        for (int type : Types)
+        {
+            for (int capacity : Capacities)
+            {
+                const Run skipped = { Skipped, 0, 0, 0, 0, -1, 0 };
+                if (rangeFor(type, n) == 0)
+                {
+                    report(out, type, n, capacity, 0, exact->name(), o, skipped, 0);
+                    continue;
+                }
+
+                const std::string path = o.dir + "/t" + std::to_string(type) + "_n" + std::to_string(n) +
+                    "_c" + std::to_string(capacity) + ".kbin";
+                int Cap = 0;
+                int Profit = 0;
+                KnapsackInstance items;
+                if (generate(o, type, n, capacity, path))
+                    items = loadItems(path, Cap, Profit);
+                if (!fitsInt(items, Cap))
+                {
+                    report(out, type, n, capacity, Cap, exact->name(), o, skipped, 0);
+                    continue;
+                }
+
+                Run optimal = solveIsolated(*exact, items, Cap, options, -1, -1);
+                optimal.targetMs = optimal.seconds * 1000;
+                const long long optimum = optimal.status == Ok ? optimal.profit : -1;
+                report(out, type, n, capacity, Cap, exact->name(), o, optimal, optimum);
+                failed += optimal.status == Failed;
+
+                const long long target = optimum < 0 ? -1 : optimum - (long long)(o.targetGap * double(optimum));
+                for (auto& solver : heuristics)
+                {
+                    const Run run = solveIsolated(*solver, items, Cap, options, target, optimum);
+                    report(out, type, n, capacity, Cap, solver->name(), o, run, optimum);
+                    failed += run.status == Failed;
+                }
+            }
+        }
+    }
+
+    fclose(out);
+    if (failed > 0)
+        printf("%d runs failed\n", failed);
+    return failed > 0;
+}
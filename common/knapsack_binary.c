@@ -0,0 +1,179 @@
+/* ======================================================================
+           binary instance and solution files
+   ====================================================================== */
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "knapsack_binary.h"
+
+
+/* ======================================================================
+                layout
+   ====================================================================== */
+
+/* profits or weights, padded to 8 bytes from version 2 on */
+static uint64_t section_size(const knap_header *h)
+{
+    uint64_t bytes = h->n * (h->itembits / 8);
+    return h->version >= 2 ? (bytes + 7) / 8 * 8 : bytes;
+}
+
+static uint64_t solution_size(const knap_header *h)
+{
+    return (h->flags & KNAP_HAS_SOLUTION) ? ((h->n + 63) / 64) * 8 : 0;
+}
+
+static uint64_t file_size(const knap_header *h)
+{
+    return sizeof(knap_header) + 2 * section_size(h) + solution_size(h);
+}
+
+void knap_init_header(knap_header *h, uint64_t n, int itembits,
+                      int64_t capacity, int64_t profit, int hasSolution)
+{
+    memset(h, 0, sizeof(*h));
+    memcpy(h->magic, KNAP_MAGIC, 4);
+    h->version  = KNAP_VERSION;
+    h->itembits = (uint32_t)itembits;
+    h->flags    = hasSolution ? KNAP_HAS_SOLUTION : 0;
+    h->n        = n;
+    h->capacity = capacity;
+    h->profit   = profit;
+}
+
+int knap_is_binary_path(const char *path)
+{
+    size_t len = strlen(path), ext = strlen(KNAP_EXTENSION);
+    return len >= ext && strcmp(path + len - ext, KNAP_EXTENSION) == 0;
+}
+
+
+/* ======================================================================
+                mapping
+   ====================================================================== */
+
+static int map_file(const char *path, knap_file *f)
+{
+#ifdef _WIN32
+    HANDLE file, mapping;
+    LARGE_INTEGER size;
+
+    file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                       OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) return 0;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return 0;
+    }
+    mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (mapping == NULL) return 0;
+    f->base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (f->base == NULL) {
+        CloseHandle(mapping);
+        return 0;
+    }
+    f->size   = (size_t)size.QuadPart;
+    f->handle = mapping;
+#else
+    int fd;
+    struct stat st;
+    void *base;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return 0;
+    }
+    base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return 0;
+    madvise(base, (size_t)st.st_size, MADV_SEQUENTIAL);
+    f->base   = base;
+    f->size   = (size_t)st.st_size;
+    f->handle = NULL;
+#endif
+    return 1;
+}
+
+int knap_open(const char *path, knap_file *f)
+{
+    const knap_header *h;
+    const char *base;
+
+    memset(f, 0, sizeof(*f));
+    if (!map_file(path, f)) return KNAP_ERR_OPEN;
+
+    h = (const knap_header *)f->base;
+    if (f->size < sizeof(knap_header) ||
+        memcmp(h->magic, KNAP_MAGIC, 4) != 0 ||
+        h->version < 1 || h->version > KNAP_VERSION ||
+        (h->itembits != 32 && h->itembits != 64) ||
+        h->n > (uint64_t)f->size ||
+        file_size(h) > (uint64_t)f->size) {
+        knap_close(f);
+        return KNAP_ERR_FORMAT;
+    }
+
+    base = (const char *)f->base;
+    f->header = h;
+    f->p = base + sizeof(knap_header);
+    f->w = base + sizeof(knap_header) + section_size(h);
+    f->x = (h->flags & KNAP_HAS_SOLUTION) ?
+        base + sizeof(knap_header) + 2 * section_size(h) : NULL;
+    return KNAP_OK;
+}
+
+void knap_close(knap_file *f)
+{
+    if (f->base != NULL) {
+#ifdef _WIN32
+        UnmapViewOfFile(f->base);
+        CloseHandle((HANDLE)f->handle);
+#else
+        munmap(f->base, f->size);
+#endif
+    }
+    memset(f, 0, sizeof(*f));
+}
+
+
+/* ======================================================================
+                writing
+   ====================================================================== */
+
+int knap_write(const char *path, const knap_header *h,
+               const void *p, const void *w, const uint64_t *x)
+{
+    static const char zeros[8] = { 0 };
+    FILE *out;
+    size_t bytes, padding;
+    int ok;
+
+    out = fopen(path, "wb");
+    if (out == NULL) return KNAP_ERR_OPEN;
+    bytes = (size_t)(h->n * (h->itembits / 8));
+    padding = (size_t)section_size(h) - bytes;
+    ok = fwrite(h, sizeof(knap_header), 1, out) == 1;
+    ok = ok && (bytes == 0 || fwrite(p, bytes, 1, out) == 1);
+    ok = ok && (padding == 0 || fwrite(zeros, padding, 1, out) == 1);
+    ok = ok && (bytes == 0 || fwrite(w, bytes, 1, out) == 1);
+    ok = ok && (padding == 0 || fwrite(zeros, padding, 1, out) == 1);
+    if (ok && (h->flags & KNAP_HAS_SOLUTION)) {
+        bytes = (size_t)solution_size(h);
+        ok = bytes == 0 || fwrite(x, bytes, 1, out) == 1;
+    }
+    ok = (fclose(out) == 0) && ok;
+    return ok ? KNAP_OK : KNAP_ERR_WRITE;
+}
@@ -0,0 +1,151 @@
+/* ======================================================================
+           KNAPSACK_BINARY.H, binary instance and solution files
+   ====================================================================== */
+
+/* A ".kbin" file holds one instance and optionally one solution:
+ *
+ *   knap_header            64 bytes
+ *   profits                n items of itembits/8 bytes, padded to 8
+ *   weights                n items of itembits/8 bytes, padded to 8
+ *   solution               (n+63)/64 little endian 64-bit words,
+ *                          present if KNAP_HAS_SOLUTION is set
+ *
+ * Every section starts on an 8 byte boundary, so a mapped file is used
+ * in place. Version 1 files, which have no padding, are still read; with
+ * 32-bit items and an odd n their solution is only 4 byte aligned, so it
+ * is read a byte at a time. Values are stored in the byte order of the
+ * writer; the magic and version are checked on open, the byte order is
+ * not.
+ *
+ *          knap_file f;
+ *          if (knap_open("inst.kbin", &f) == KNAP_OK) {
+ *            ... knap_profit(&f, i), knap_weight(&f, i) ...
+ *            knap_close(&f);
+ *          }
+ */
+
+#ifndef KNAPSACK_BINARY_H
+#define KNAPSACK_BINARY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define KNAP_MAGIC        "KNAP"
+#define KNAP_VERSION      2
+#define KNAP_EXTENSION    ".kbin"
+
+/* header flags */
+#define KNAP_HAS_SOLUTION 1
+
+/* status codes */
+#define KNAP_OK           0
+#define KNAP_ERR_OPEN    -1   /* file could not be opened or mapped */
+#define KNAP_ERR_FORMAT  -2   /* not a knapsack file, or truncated  */
+#define KNAP_ERR_WRITE   -3   /* file could not be written          */
+
+typedef struct {
+    char     magic[4];        /* KNAP_MAGIC                         */
+    uint32_t version;         /* KNAP_VERSION                       */
+    uint32_t itembits;        /* 32 or 64                           */
+    uint32_t flags;
+    uint64_t n;               /* number of items                    */
+    int64_t  capacity;
+    int64_t  profit;          /* profit of the solution, or -1      */
+    uint64_t reserved[3];
+} knap_header;
+
+typedef struct {
+    const knap_header *header;
+    const void        *p;     /* int32_t or int64_t per itembits */
+    const void        *w;
+    const void        *x;     /* solution words, NULL without one;
+                                 not aligned in version 1 files */
+
+    /* mapping, private */
+    void              *base;
+    size_t             size;
+    void              *handle;
+} knap_file;
+
+void knap_init_header(knap_header *h, uint64_t n, int itembits,
+                      int64_t capacity, int64_t profit, int hasSolution);
+
+/* maps path read-only and validates it */
+int  knap_open(const char *path, knap_file *f);
+void knap_close(knap_file *f);
+
+/* writes a file, p and w are of the width given by h->itembits and x
+ * is only read if h->flags has KNAP_HAS_SOLUTION */
+int  knap_write(const char *path, const knap_header *h,
+                const void *p, const void *w, const uint64_t *x);
+
+/* true if path ends in KNAP_EXTENSION */
+int  knap_is_binary_path(const char *path);
+
+static inline int64_t knap_profit(const knap_file *f, size_t i)
+{
+    return f->header->itembits == 32 ? ((const int32_t *)f->p)[i]
+                                     : ((const int64_t *)f->p)[i];
+}
+
+static inline int64_t knap_weight(const knap_file *f, size_t i)
+{
+    return f->header->itembits == 32 ? ((const int32_t *)f->w)[i]
+                                     : ((const int64_t *)f->w)[i];
+}
+
+static inline int knap_solution(const knap_file *f, size_t i)
+{
+    /* bit i of the little endian words is bit i % 8 of byte i / 8 */
+    return f->x != NULL && ((((const unsigned char *)f->x)[i / 8] >> (i % 8)) & 1) != 0;
+}
+
+#ifdef __cplusplus
+}
+
+#include <cstring>
+#include <string>
+
+#include "knapsack_instance.h"
+
+// loads a binary instance into items, Profit is the stored solution's
+// profit; fails if the file is unreadable or a value does not fit in int
+inline bool loadBinaryItems(const std::string& filepath, KnapsackInstance& items, int& Cap, int& Profit)
+{
+    knap_file f;
+    if (knap_open(filepath.c_str(), &f) != KNAP_OK)
+        return false;
+
+    const knap_header& h = *f.header;
+    const size_t n = size_t(h.n);
+    bool ok = h.capacity >= INT32_MIN && h.capacity <= INT32_MAX &&
+        h.profit >= INT32_MIN && h.profit <= INT32_MAX;
+    items.resize(n);
+    if (h.itembits == 32)
+    {
+        std::memcpy(items.c.data(), f.p, n * sizeof(int32_t));
+        std::memcpy(items.w.data(), f.w, n * sizeof(int32_t));
+    }
+    else
+    {
+        for (size_t i = 0; ok && i < n; ++i)
+        {
+            const int64_t p = knap_profit(&f, i);
+            const int64_t w = knap_weight(&f, i);
+            ok = p >= INT32_MIN && p <= INT32_MAX && w >= INT32_MIN && w <= INT32_MAX;
+            items.c[i] = int(p);
+            items.w[i] = int(w);
+        }
+    }
+    Cap = int(h.capacity);
+    Profit = int(h.profit);
+    knap_close(&f);
+    return ok;
+}
+#endif
+
+#endif
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// packed 0-1 solution vector, one bit per item
+class Bitset
+{
+public:
+    using Word = uint64_t;
+    static const int WordBits = 64;
+
+    Bitset() : m_size(0) {}
+    explicit Bitset(size_t size)
+        : m_words((size + WordBits - 1) / WordBits, 0)
+        , m_size(size)
+    {
+    }
+
+    size_t size() const { return m_size; }
+    size_t numWords() const { return m_words.size(); }
+    const Word* data() const { return m_words.data(); }
+    Word* data() { return m_words.data(); }
+
+    bool test(size_t i) const { return (m_words[i / WordBits] >> (i % WordBits)) & 1; }
+    void set(size_t i) { m_words[i / WordBits] |= Word(1) << (i % WordBits); }
+    void reset(size_t i) { m_words[i / WordBits] &= ~(Word(1) << (i % WordBits)); }
+    void flip(size_t i) { m_words[i / WordBits] ^= Word(1) << (i % WordBits); }
+    void assign(size_t i, bool value) { if (value) set(i); else reset(i); }
+
+    void clear() { std::fill(m_words.begin(), m_words.end(), Word(0)); }
+
+    // positions of the lowest and the highest set bit of a word other than 0
+    static int lowestBit(Word word)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return int(index);
+#else
+        return __builtin_ctzll(word);
+#endif
+    }
+
+    static int highestBit(Word word)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanReverse64(&index, word);
+        return int(index);
+#else
+        return WordBits - 1 - __builtin_clzll(word);
+#endif
+    }
+
+private:
+    std::vector<Word> m_words;
+    size_t m_size;
+};
+
+// knapsack items stored as a structure of arrays,
+// so that scans over costs and weights are stride-1
+struct KnapsackInstance
+{
+    std::vector<int> c; // costs
+    std::vector<int> w; // weights
+
+    size_t size() const { return c.size(); }
+
+    void resize(size_t size)
+    {
+        c.resize(size, 0);
+        w.resize(size, 0);
+    }
+
+    // weight and cost of the given solution
+    void evaluate(const Bitset& x, long long& W, long long& C) const
+    {
+        W = 0;
+        C = 0;
+        const int n = int(size());
+        for (int i = 0; i < n; ++i)
+        {
+            const int mask = -int(x.test(i));
+            W += w[i] & mask;
+            C += c[i] & mask;
+        }
+    }
+};
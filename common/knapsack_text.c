@@ -0,0 +1,219 @@
+/* ======================================================================
+           buffered parser for the text layouts
+   ====================================================================== */
+
+/* The input is read in large blocks and scanned one line at a time.
+ * A line is split into integers; any other token (the "C W" of the
+ * test.out header) only sets a flag. Blank lines are skipped.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "knapsack_text.h"
+
+#define BLOCKSIZE (1 << 20)   /* bytes read at a time */
+#define MAXCOLS   8           /* longest line of interest */
+
+struct knap_text_reader {
+    FILE   *in;
+    int     owned;            /* in was opened by the reader */
+    char   *buf;
+    size_t  pos, len;
+    long    line;             /* number of the line read last */
+    char    error[96];
+};
+
+
+/* ======================================================================
+                reader
+   ====================================================================== */
+
+static knap_text_reader *create(FILE *in, int owned)
+{
+    knap_text_reader *r;
+
+    r = (knap_text_reader *)malloc(sizeof(knap_text_reader));
+    if (r == NULL) return NULL;
+    r->buf = (char *)malloc(BLOCKSIZE);
+    if (r->buf == NULL) {
+        free(r);
+        return NULL;
+    }
+    r->in = in;
+    r->owned = owned;
+    r->pos = r->len = 0;
+    r->line = 0;
+    r->error[0] = '\0';
+    return r;
+}
+
+knap_text_reader *knap_text_open(const char *path)
+{
+    knap_text_reader *r;
+    FILE *in;
+
+    in = fopen(path, "rb");
+    if (in == NULL) return NULL;
+    r = create(in, 1);
+    if (r == NULL) fclose(in);
+    return r;
+}
+
+knap_text_reader *knap_text_attach(FILE *in)
+{
+    return create(in, 0);
+}
+
+void knap_text_close(knap_text_reader *r)
+{
+    if (r == NULL) return;
+    if (r->owned) fclose(r->in);
+    free(r->buf);
+    free(r);
+}
+
+const char *knap_text_error(const knap_text_reader *r)
+{
+    return r->error;
+}
+
+static int fail(knap_text_reader *r, const char *what)
+{
+    sprintf(r->error, "line %ld: %s", r->line, what);
+    return KNAP_ERR_FORMAT;
+}
+
+static int fail_count(knap_text_reader *r, const char *what, int expected, int found)
+{
+    sprintf(r->error, "line %ld: %s (expected %d numbers, found %d)",
+            r->line, what, expected, found);
+    return KNAP_ERR_FORMAT;
+}
+
+
+/* ======================================================================
+                scanning
+   ====================================================================== */
+
+static int refill(knap_text_reader *r)
+{
+    r->len = fread(r->buf, 1, BLOCKSIZE, r->in);
+    r->pos = 0;
+    return r->len > 0;
+}
+
+#define PEEK(r)   ((r)->pos < (r)->len || refill(r) ? (unsigned char)(r)->buf[(r)->pos] : -1)
+
+/* reads the integers of the next line into v, returns their number, or
+ * -1 at the end of input. Lines with more than MAXCOLS integers or with
+ * a number out of range return MAXCOLS+1. */
+static int read_line(knap_text_reader *r, int64_t *v, int *text)
+{
+    int c, count, neg, digits;
+    int64_t x;
+
+    *text = 0;
+    count = 0;
+    c = PEEK(r);
+    if (c < 0) return -1;
+    r->line++;
+    for (;;) {
+        /* skip blanks */
+        while (c == ' ' || c == '\t' || c == '\r') { r->pos++; c = PEEK(r); }
+        if (c < 0) break;
+        if (c == '\n') { r->pos++; break; }
+
+        neg = 0;
+        if (c == '-' || c == '+') { neg = c == '-'; r->pos++; c = PEEK(r); }
+        x = 0; digits = 0;
+        while (c >= '0' && c <= '9') {
+            if (x > (INT64_MAX - (c - '0')) / 10) count = MAXCOLS;
+            else x = 10 * x + (c - '0');
+            digits++;
+            r->pos++;
+            c = PEEK(r);
+        }
+        if (digits == 0 || (c >= 0 && c != ' ' && c != '\t' && c != '\r' && c != '\n')) {
+            /* not a number, skip the token */
+            *text = 1;
+            while (c >= 0 && c != ' ' && c != '\t' && c != '\r' && c != '\n') { r->pos++; c = PEEK(r); }
+            continue;
+        }
+        if (count < MAXCOLS) v[count] = neg ? -x : x;
+        if (count <= MAXCOLS) count++;
+    }
+    return count;
+}
+
+/* as read_line, skipping blank lines */
+static int next_line(knap_text_reader *r, int64_t *v, int *text)
+{
+    int count;
+    do { count = read_line(r, v, text); } while (count == 0 && !*text);
+    return count;
+}
+
+
+/* ======================================================================
+                instances
+   ====================================================================== */
+
+int knap_text_header(knap_text_reader *r, knap_text_info *info)
+{
+    int64_t v[MAXCOLS];
+    int count, text;
+
+    count = next_line(r, v, &text);
+    if (count < 0) {
+        sprintf(r->error, "line %ld: no instance", r->line);
+        return KNAP_END;
+    }
+    if (count != 1 || v[0] < 1) return fail_count(r, "bad header", 1, count);
+    info->n = v[0];
+    info->withSolution = text;
+    info->capacity = 0;
+    info->profit = -1;
+    return KNAP_OK;
+}
+
+int knap_text_items(knap_text_reader *r, knap_text_info *info, int itembits,
+                    void *p, void *w, uint64_t *x)
+{
+    int64_t v[MAXCOLS], i, first;
+    int count, text, cols;
+
+    cols = info->withSolution ? 4 : 3;
+    if (x != NULL && info->withSolution) memset(x, 0, (size_t)((info->n + 63) / 64) * sizeof(uint64_t));
+    first = 0;
+    for (i = 0; i < info->n; i++) {
+        count = next_line(r, v, &text);
+        if (count != cols || text) return fail_count(r, "bad item", cols, count);
+        if (i == 0) first = v[0];
+        if (v[0] != first + i) return fail(r, "item out of order");
+        if (itembits == 32) {
+            if (v[1] < INT32_MIN || v[1] > INT32_MAX || v[2] < INT32_MIN || v[2] > INT32_MAX)
+                return fail(r, "value does not fit in 32 bits");
+            ((int32_t *)p)[i] = (int32_t)v[1];
+            ((int32_t *)w)[i] = (int32_t)v[2];
+        } else {
+            ((int64_t *)p)[i] = v[1];
+            ((int64_t *)w)[i] = v[2];
+        }
+        if (cols == 4) {
+            if (v[3] != 0 && v[3] != 1) return fail(r, "solution is not 0 or 1");
+            if (x != NULL && v[3]) x[i / 64] |= (uint64_t)1 << (i % 64);
+        }
+    }
+
+    count = next_line(r, v, &text);
+    if (count != 1 || text) return fail_count(r, "bad capacity", 1, count);
+    info->capacity = v[0];
+    if (info->withSolution) {
+        count = next_line(r, v, &text);
+        if (count != 1 || text) return fail_count(r, "bad profit", 1, count);
+        info->profit = v[0];
+    }
+    return KNAP_OK;
+}
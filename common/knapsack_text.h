@@ -0,0 +1,102 @@
+/* ======================================================================
+           KNAPSACK_TEXT.H, buffered parser for the text layouts
+   ====================================================================== */
+
+/* Two text layouts are in use:
+ *
+ *   test.in   "n", then n lines "i p w", then the capacity
+ *   test.out  "n C W", then n lines "i p w x", then the capacity and
+ *             the profit of the solution x
+ *
+ * The reader tells them apart by the header line and checks that every
+ * item line has the right number of columns and consecutive indices, so
+ * a wrong count is reported instead of being read as the capacity.
+ * Several instances may follow each other in one stream.
+ *
+ *          knap_text_reader *r = knap_text_open("test.out");
+ *          knap_text_info info;
+ *          while (knap_text_header(r, &info) == KNAP_OK) {
+ *            ... allocate info.n items ...
+ *            knap_text_items(r, &info, 32, p, w, x);
+ *          }
+ *          knap_text_close(r);
+ */
+
+#ifndef KNAPSACK_TEXT_H
+#define KNAPSACK_TEXT_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "knapsack_binary.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* returned by knap_text_header() when the stream holds no more instances;
+ * the other status codes are those of knapsack_binary.h */
+#define KNAP_END          1
+
+typedef struct {
+    int64_t n;
+    int     withSolution;   /* test.out layout */
+    int64_t capacity;       /* set by knap_text_items() */
+    int64_t profit;         /* set by knap_text_items(), -1 for test.in */
+} knap_text_info;
+
+typedef struct knap_text_reader knap_text_reader;
+
+/* NULL if the file cannot be opened */
+knap_text_reader *knap_text_open(const char *path);
+/* reads from an open stream, which stays owned by the caller */
+knap_text_reader *knap_text_attach(FILE *in);
+void knap_text_close(knap_text_reader *r);
+
+/* reads the header line of the next instance */
+int knap_text_header(knap_text_reader *r, knap_text_info *info);
+
+/* reads the items and the trailing lines of the instance. p and w hold
+ * info->n values of itembits (32 or 64) bits; x receives the solution
+ * as (n+63)/64 words if the layout has one and x is not NULL */
+int knap_text_items(knap_text_reader *r, knap_text_info *info, int itembits,
+                    void *p, void *w, uint64_t *x);
+
+/* describes the last error, with its line number */
+const char *knap_text_error(const knap_text_reader *r);
+
+#ifdef __cplusplus
+}
+
+#include <string>
+#include <vector>
+
+#include "knapsack_instance.h"
+
+// loads a text instance into items, Profit is -1 for the test.in layout;
+// fails on malformed input or values that do not fit in int
+inline bool loadTextItems(const std::string& filepath, KnapsackInstance& items, int& Cap, int& Profit)
+{
+    knap_text_reader* r = knap_text_open(filepath.c_str());
+    if (r == nullptr)
+        return false;
+
+    knap_text_info info;
+    bool ok = knap_text_header(r, &info) == KNAP_OK;
+    if (ok)
+    {
+        items.resize(size_t(info.n));
+        ok = knap_text_items(r, &info, 32, items.c.data(), items.w.data(), nullptr) == KNAP_OK &&
+            info.capacity >= INT32_MIN && info.capacity <= INT32_MAX &&
+            info.profit >= INT32_MIN && info.profit <= INT32_MAX;
+        Cap = int(info.capacity);
+        Profit = int(info.profit);
+    }
+    if (!ok)
+        fprintf(stderr, "%s: %s\n", filepath.c_str(), knap_text_error(r));
+    knap_text_close(r);
+    return ok;
+}
+#endif
+
+#endif
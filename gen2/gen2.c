@@ -21,7 +21,7 @@
  * 
  * The code is run by issuing the command
  *
- *   gen2 n r type i S
+ *   gen2 n r type i S [file]
  *
  * where n: number of items, 
  *       r: range of coefficients, 
@@ -33,7 +33,9 @@
  *             14=bounded strongly corr, 15=No small weights
  *       i: instance no
  *       S: number of tests in series (typically 1000)
- * output will be written to the file "test.in".
+ * output will be written to the file "test.in", or to file if given;
+ * a file ending in ".kbin" is written in the binary format of
+ * knapsack_binary.h.
  *
  * Please do not re-distribute. A new copy can be obtained by contacting
  * the author at the adress below. Errors and questions are refered to:
@@ -53,6 +55,8 @@
 #include <string.h>
 #include <malloc.h>
 
+#include "../common/knapsack_binary.h"
+
 
 /* ======================================================================
 				     macros
@@ -71,7 +75,7 @@ typedef int (*funcptr) (const void *, const void *);
    ====================================================================== */
 
 typedef int   boolean; /* boolean variables */
-typedef short itype;   /* item profits and weights */
+typedef int   itype;   /* item profits and weights */
 typedef long  stype;   /* sum of pofit or weight */
 
 /* item */
@@ -148,17 +152,38 @@ void * palloc(size_t no, size_t each)
 }
 
 
+/* ======================================================================
+                                writebinary
+   ====================================================================== */
+
+void writebinary(item *f, item *l, stype c, char *name)
+{
+  item *i;
+  int32_t *p, *w;
+  knap_header h;
+
+  p = palloc(NO(f,l), sizeof(int32_t));
+  w = palloc(NO(f,l), sizeof(int32_t));
+  for (i = f; i <= l; i++) { p[i-f] = i->p; w[i-f] = i->w; }
+  knap_init_header(&h, NO(f,l), 32, c, -1, 0);
+  if (knap_write(name, &h, p, w, NULL) != KNAP_OK) error("no file");
+  pfree(p);
+  pfree(w);
+}
+
+
 /* ======================================================================
                                 showitems
    ====================================================================== */
 
-void showitems(item *f, item *l, stype c)
+void showitems(item *f, item *l, stype c, char *name)
 {
   item *i;
   stype ps, ws;
   FILE *out;
  
-  out = fopen("test.in", "w"); 
+  if (knap_is_binary_path(name)) { writebinary(f, l, c, name); return; }
+  out = fopen(name, "w"); 
   if (out == NULL) error("no file");
   fprintf(out,"%d\n", NO(f,l));
   for (i = f; i <= l; i++) {
@@ -326,8 +351,11 @@ void main(int argc, char *argv[])
   item *f, *l;
   int n, r, type, i, S;
   stype c;
+  char *name;
  
-  if (argc == 6) {
+  name = "test.in";
+  if (argc == 7) name = argv[6];
+  if (argc == 6 || argc == 7) {
     n = atoi(argv[1]);
     r = atoi(argv[2]);
     type = atoi(argv[3]);
@@ -351,7 +379,7 @@ void main(int argc, char *argv[])
   f = palloc(n, sizeof(item));
   l = f + n-1;
   c = maketest(f, l, r, type, i, S); 
-  showitems(f, l, c);
+  showitems(f, l, c, name);
   pfree(f);
 }
 
@@ -1,221 +1,91 @@
 #include <iostream>
 #include <vector>
 #include <string>
-#include <set>
 #include <chrono>
-#include <cstdarg>
 #include <cstdio>
 #include <algorithm>
+#include <thread>
+#include <atomic>
 
+#include "../solvers/hill_climbing.h"
+#include "../solvers/core_reduction.h"
+#include "../solvers/improvement_trace.h"
+#include "../solvers/instance_io.h"
 
-struct Item
+
+struct PassResult
 {
-    int c; // cost
-    int w; // weight
-    bool x; // solution variable
+    Bitset x;
+    int profit;
 
-    Item() : c(0), w(0), x(false) {}
+    PassResult() : profit(-1) {}
 };
 
-using State = std::vector<Item>;
-
-void log(FILE* f, const char* format, ...)
+// runs numStarts independent passes on a pool of numThreads workers
+// pass i is seeded with (seed, i), so its result doesn't depend on the scheduling
+PassResult runPasses(const KnapsackInstance& items, int Cap, int Profit, long long upperBound, const Solver& solver,
+    int numStarts, int numThreads, unsigned long long seed, FILE* logfile, ImprovementTrace& trace)
 {
-    va_list args;
-    va_start(args, format);
-
-
-    char buffer[1024];
-    vsnprintf(buffer, sizeof(buffer), format, args);
-    printf("%s", buffer);
-    fprintf(f, "%s", buffer);
-
-    fflush(f);
-
+    std::atomic<int> nextPass(0);
+    std::vector<PassResult> bestPerWorker(numThreads);
 
-    va_end(args);
-}
-
-
-State loadItems(const std::string& filepath, int& Cap, int& Profit)
-{
-    std::vector<Item> items;
-    // load items from file
-    FILE* in = fopen(filepath.c_str(), "r");
-    if (in != NULL)
+    auto worker = [&](int workerIndex)
     {
-        int len = 0;
-        char d1, d2;
-        fscanf(in, "%d %c %c\n", &len, &d1, &d2);
-
-        items.resize(len);
-
-        for (int i = 0; i < len; i++)
+        PassResult& best = bestPerWorker[workerIndex];
+        for (int i = nextPass++; i < numStarts; i = nextPass++)
         {
-            int n = 0;
-            int x = 0;
-            fscanf(in, "%d %d %d %d\n", &n, &items[i].c, &items[i].w, &x);
-        }
-
-        fscanf(in, "%d\n", &Cap);
-        fscanf(in, "%d\n", &Profit);
+            SolverOptions options;
+            options.seed = seed;
+            options.stream = i;
+            options.upperBound = upperBound;
 
-        fclose(in);
-    }
-
-    return items;
-}
+            log(logfile, "Pass %d started\n", i);
 
-void saveItems(const std::string& filepath, const State& items, int cap, int cost)
-{
-    FILE* out = fopen(filepath.c_str(), "w");
-    if (out != NULL)
-    {
-        fprintf(out, "%5llu     C     W\n", items.size());
-        for (int i = 0; i < items.size(); ++i)
-        {
-            fprintf(out, "%5d %5d %5d %5d\n", i, items[i].c, items[i].w, items[i].x);
-        }
-        fprintf(out, "%d\n", cap);
-        fprintf(out, "%d\n", cost);
-        fclose(out);
-    }
-}
+            std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+            options.onImprove = trace.callback(i);
 
-void initRandomState(State& state, int Cap)
-{
-    int W = 0;
-    for (int i = 0; i < state.size(); ++i )
-    {
-        int j = rand() % state.size();
-        if (W + state[j].w <= Cap)
-        {
-            state[j].x = true;
-            W += state[j].w;
-        }
-    }
-}
+            SolverResult result = solver.solve(items, Cap, options);
+            const int profit = int(result.profit);
+            if (result.stats.coreSize > 0)
+                log(logfile, "The core has %lld of %llu items\n", result.stats.coreSize, items.size());
+            log(logfile, "After %lld iterations the best profit is = %d\n", result.stats.iterations, profit);
 
-void findNeighbour(const State& x, int distance, std::set<int>& flipped )
-{
-    int rdistance = rand() % distance + 1;
-    for (int i = 0; i < rdistance; ++i)
-    {
-        int flip = rand() % x.size();
-        // avoid double flips
-        if (flipped.find(flip) == flipped.end())
-        {
-            flipped.insert(flip);
-        }
-    }
-}
+            std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+            log(logfile, "Pass %d finished in %.3f seconds\n", i, std::chrono::duration<double>(end - begin).count());
+            log(logfile, "Pass %d: the correlation with benchmark = %d, the gap to the bound = %s%s\n",
+                i, Profit - profit, gapText(upperBound, profit).c_str(), result.stats.optimal ? ", optimal" : "");
+            log(logfile, "===================================\n");
 
-int evaluateFull(State& x, int& W0, int& C0, int Cap)
-{
-    for (auto& s : x)
-    {
-        if (s.x)
-        {
-            W0 += s.w;
-            C0 += s.c;
-        }
-    }
+            std::string filename = "testMy" + std::to_string(i) + ".out";
 
-    return W0 > Cap ? 0 : C0;
-}
+            saveItems(filename, items, result.x, Cap, profit);
 
-int evaluateDelta(const State& x, int W0, int C0, int Cap, const std::set<int>& modified, int& Wy, int& Cy)
-{
-    Wy = W0;
-    Cy = C0;
-    for (auto& i : modified)
-    {
-        bool flip = !x[i].x;
-        if (flip)
-        {
-            Wy += x[i].w;
-            Cy += x[i].c;
-        }
-        else
-        {
-            Wy -= x[i].w;
-            Cy -= x[i].c;
+            if (profit > best.profit)
+            {
+                best.x = std::move(result.x);
+                best.profit = profit;
+            }
         }
-    }
+    };
 
-    return Wy > Cap ? 0 : Cy;
-}
+    std::vector<std::thread> threads;
+    for (int t = 1; t < numThreads; ++t)
+        threads.emplace_back(worker, t);
+    worker(0);
+    for (auto& t : threads)
+        t.join();
 
-void updateDelta(State& x, const std::set<int>& modified)
-{
-    for (auto& i : modified)
+    PassResult best;
+    for (auto& r : bestPerWorker)
     {
-        x[i].x = !x[i].x;
+        if (r.profit > best.profit)
+            best = std::move(r);
     }
-
+    return best;
 }
 
-void hillclimbing(State& x, int Cap, int numAttempts, int& profit, FILE* logfile)
-{
-    initRandomState(x, Cap);
-    int W0 = 0; 
-    int C0 = 0;
-    int Px = evaluateFull(x, W0, C0, Cap);
-
-    profit = Px;
-
-    log(logfile, "Initial state profit = %d\n", Px);
-
-    bool found = true;
-    int ndistance = x.size() / 2;
-
-    int numIterations = 0;
-
-    while (ndistance >= 1)
-    {
-        found = false;
-        for (int i = 0; i < numAttempts; ++i)
-        {
-            ++numIterations;
-            std::set<int> flipped;
-            findNeighbour(x, ndistance, flipped);
-
-            int Wy = 0;
-            int Cy = 0;
-
-            int Py = evaluateDelta(x, W0, C0, Cap, flipped, Wy, Cy );
-            
-            if( Py > Px )
-            {
-                log(logfile, "%7d\t%5d\n", numIterations, Py);
-                profit = Py;
-                updateDelta(x, flipped);
-                W0 = Wy;
-                C0 = Cy;
-                Px = Py;
-                found = true;
-                ndistance = ndistance * 2;
-                if( ndistance > x.size() )
-                    ndistance = x.size();
-
-                break;
-            }
-        }
-        if (!found)
-        {
-            ndistance = ndistance / 2;
-        }
-    }
-
-    log(logfile, "After %d iterations the best profit is = %d\n", numIterations, profit );
-}
-
-
-
 int main(int argc, char* argv[])
 {
-    srand(time(NULL));
-
     int numStarts = 1;
     if( argc >= 2 )
         numStarts = atoi(argv[1]);
@@ -224,39 +94,71 @@ int main(int argc, char* argv[])
     if (argc >= 3)
         numAttempts = atoi(argv[2]);
 
-    
-    int Cap = 0;
-    int Profit = 0;
+    int numThreads = std::max(1u, std::thread::hardware_concurrency());
+    if (argc >= 4)
+        numThreads = std::max(1, atoi(argv[3]));
+    numThreads = std::min(numThreads, std::max(1, numStarts));
 
-    State items = loadItems("test.out", Cap, Profit);
+    unsigned long long seed = time(NULL);
+    if (argc >= 5)
+        seed = strtoull(argv[4], NULL, 10);
 
-    FILE* logfile = fopen("log.txt", "w");
+    // test.out layout, or a binary .kbin file
+    std::string input = "test.out";
+    if (argc >= 6)
+        input = argv[5];
 
-    log(logfile, "Benchmark data: Num items = %llu, Cap = %d, Profit = %d\n", items.size(), Cap, Profit );
-    log(logfile, "NumStarts = %d, NumAttempts = %d\n", numStarts, numAttempts);
+    // 0 - random multi-flips, 1 - variable neighbourhood descent
+    int neighbourhoods = 0;
+    if (argc >= 7)
+        neighbourhoods = atoi(argv[6]);
 
-    auto time = std::chrono::system_clock::now();
+    // 1 - repair infeasible neighbours and fill underfull ones
+    bool repair = false;
+    if (argc >= 8)
+        repair = atoi(argv[7]) != 0;
 
-    for (int i = 0; i < numStarts; ++i)
-    {
-        State x = items;
-//        sortItems(x);
-        int profit = 0;
-        log(logfile, "Pass %d started\n", i);
+    // 1 - search only the core left by fixing items with reduced costs
+    bool core = false;
+    if (argc >= 9)
+        core = atoi(argv[8]) != 0;
+
+    int Cap = 0;
+    int Profit = 0;
+
+    KnapsackInstance items = loadItems(input, Cap, Profit);
 
-        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    // every pass stops once it reaches the bound
+    const long long upperBound = dantzigBound(items, Cap);
 
-        hillclimbing(x, Cap, numAttempts, profit, logfile);
+    FILE* logfile = fopen("log.txt", "w");
 
-        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
-        log(logfile, "Pass %d finished in %llu seconds\n", i, std::chrono::duration_cast<std::chrono::seconds>(end - begin).count());
-        log(logfile, "The correlation with benchmark = %d\n", Profit - profit);
-        log(logfile, "===================================\n");
+    log(logfile, "Benchmark data: Num items = %llu, Cap = %d, Profit = %d, Dantzig bound = %lld\n",
+        items.size(), Cap, Profit, upperBound);
+    log(logfile, "NumStarts = %d, NumAttempts = %d, NumThreads = %d, Seed = %llu, Neighbourhoods = %d, Repair = %d, Core = %d\n",
+        numStarts, numAttempts, numThreads, seed, neighbourhoods, int(repair), int(core));
 
-        std::string filename = "testMy" + std::to_string(i) + ".out";
+    auto timeStart = std::chrono::steady_clock::now();
 
-        saveItems(filename, x, Cap, profit);
+    PassResult best;
+    {
+        // improvements of every pass, see improvement_trace.h
+        ImprovementTrace trace("trace.tsv", upperBound);
+        std::unique_ptr<Solver> solver = std::make_unique<HillClimbingSolver>(
+            numAttempts, HillClimbingSolver::Neighbourhoods(neighbourhoods), repair);
+        if (core)
+            solver = std::make_unique<CoreSolver>(std::move(solver));
+        best = runPasses(items, Cap, Profit, upperBound, *solver, numStarts, numThreads, seed, logfile, trace);
+        if (trace.dropped() > 0)
+            log(logfile, "%lld trace records were dropped\n", trace.dropped());
     }
 
+    auto timeStop = std::chrono::steady_clock::now();
+
+    log(logfile, "%d passes finished in %.3f seconds\n", numStarts,
+        std::chrono::duration<double>(timeStop - timeStart).count());
+    log(logfile, "The best profit = %d, the correlation with benchmark = %d, the gap to the bound = %s\n",
+        best.profit, Profit - best.profit, gapText(upperBound, best.profit).c_str());
+
     fclose(logfile);
-}
\ No newline at end of file
+}
@@ -0,0 +1,183 @@
+/* ======================================================================
+           KNAPCONV.C, converts between text and binary instances
+   ====================================================================== */
+
+/* The direction follows the file names:
+ *
+ *   knapconv input output
+ *
+ * A ".kbin" name is the binary format of knapsack_binary.h, anything
+ * else is text. Text input may be in the "test.in" layout written by the
+ * generators or in the "test.out" layout written by the solvers, which
+ * adds a solution column and the profit. Binary files are written with
+ * 32-bit items when all values fit and with 64-bit items otherwise;
+ * text is written in the "test.out" layout when there is a solution.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../common/knapsack_binary.h"
+#include "../common/knapsack_text.h"
+
+
+/* ======================================================================
+                instance
+   ====================================================================== */
+
+typedef struct {
+    int64_t   n;
+    int64_t  *p;
+    int64_t  *w;
+    uint64_t *x;          /* NULL without a solution */
+    int64_t   capacity;
+    int64_t   profit;
+} instance;
+
+static void free_instance(instance *t)
+{
+    free(t->p); free(t->w); free(t->x);
+    memset(t, 0, sizeof(*t));
+}
+
+static int alloc_instance(instance *t, int64_t n, int withSolution)
+{
+    t->n = n;
+    t->p = (int64_t *)malloc((size_t)n * sizeof(int64_t));
+    t->w = (int64_t *)malloc((size_t)n * sizeof(int64_t));
+    t->x = withSolution ? (uint64_t *)calloc((size_t)(n + 63) / 64 + 1, sizeof(uint64_t)) : NULL;
+    return t->p != NULL && t->w != NULL && (!withSolution || t->x != NULL);
+}
+
+
+/* ======================================================================
+                text
+   ====================================================================== */
+
+static int read_text(const char *path, instance *t)
+{
+    knap_text_reader *r;
+    knap_text_info info;
+    int status;
+
+    r = knap_text_open(path);
+    if (r == NULL) return 0;
+    status = knap_text_header(r, &info);
+    if (status == KNAP_OK && !alloc_instance(t, info.n, info.withSolution)) status = KNAP_ERR_OPEN;
+    if (status == KNAP_OK) status = knap_text_items(r, &info, 64, t->p, t->w, t->x);
+    if (status == KNAP_OK) {
+        t->capacity = info.capacity;
+        t->profit = info.profit;
+    } else {
+        printf("%s: %s\n", path, knap_text_error(r));
+    }
+    knap_text_close(r);
+    return status == KNAP_OK;
+}
+
+static int write_text(const char *path, const instance *t)
+{
+    FILE *out;
+    int64_t i;
+
+    out = fopen(path, "w");
+    if (out == NULL) return 0;
+    if (t->x != NULL) {
+        fprintf(out, "%5lld     C     W\n", (long long)t->n);
+        for (i = 0; i < t->n; i++) {
+            fprintf(out, "%5lld %5lld %5lld %5d\n", (long long)i, (long long)t->p[i],
+                (long long)t->w[i], (int)((t->x[i / 64] >> (i % 64)) & 1));
+        }
+        fprintf(out, "%lld\n", (long long)t->capacity);
+        fprintf(out, "%lld\n", (long long)t->profit);
+    } else {
+        fprintf(out, "%lld\n", (long long)t->n);
+        for (i = 0; i < t->n; i++) {
+            fprintf(out, "%5lld %5lld %5lld\n", (long long)i + 1, (long long)t->p[i],
+                (long long)t->w[i]);
+        }
+        fprintf(out, "%lld\n", (long long)t->capacity);
+    }
+    return fclose(out) == 0;
+}
+
+
+/* ======================================================================
+                binary
+   ====================================================================== */
+
+static int read_binary(const char *path, instance *t)
+{
+    knap_file f;
+    int64_t i;
+
+    if (knap_open(path, &f) != KNAP_OK) return 0;
+    if (!alloc_instance(t, (int64_t)f.header->n, f.x != NULL)) {
+        knap_close(&f);
+        return 0;
+    }
+    for (i = 0; i < t->n; i++) {
+        t->p[i] = knap_profit(&f, (size_t)i);
+        t->w[i] = knap_weight(&f, (size_t)i);
+    }
+    if (f.x != NULL) memcpy(t->x, f.x, (size_t)(t->n + 63) / 64 * sizeof(uint64_t));
+    t->capacity = f.header->capacity;
+    t->profit = f.header->profit;
+    knap_close(&f);
+    return 1;
+}
+
+static int write_binary(const char *path, const instance *t)
+{
+    knap_header h;
+    int32_t *p, *w;
+    int64_t i;
+    int narrow, status;
+
+    narrow = 1;
+    for (i = 0; narrow && i < t->n; i++) {
+        narrow = t->p[i] >= INT32_MIN && t->p[i] <= INT32_MAX &&
+                 t->w[i] >= INT32_MIN && t->w[i] <= INT32_MAX;
+    }
+    knap_init_header(&h, (uint64_t)t->n, narrow ? 32 : 64, t->capacity, t->profit, t->x != NULL);
+    if (!narrow) return knap_write(path, &h, t->p, t->w, t->x) == KNAP_OK;
+
+    p = (int32_t *)malloc((size_t)t->n * sizeof(int32_t));
+    w = (int32_t *)malloc((size_t)t->n * sizeof(int32_t));
+    status = KNAP_ERR_WRITE;
+    if (p != NULL && w != NULL) {
+        for (i = 0; i < t->n; i++) { p[i] = (int32_t)t->p[i]; w[i] = (int32_t)t->w[i]; }
+        status = knap_write(path, &h, p, w, t->x);
+    }
+    free(p); free(w);
+    return status == KNAP_OK;
+}
+
+
+/* ======================================================================
+                main
+   ====================================================================== */
+
+int main(int argc, char *argv[])
+{
+    instance t;
+    int ok;
+
+    if (argc != 3) {
+        printf("usage: knapconv input output\n");
+        return 1;
+    }
+
+    memset(&t, 0, sizeof(t));
+    ok = knap_is_binary_path(argv[1]) ? read_binary(argv[1], &t) : read_text(argv[1], &t);
+    if (!ok) {
+        printf("cannot read %s\n", argv[1]);
+        free_instance(&t);
+        return 1;
+    }
+    ok = knap_is_binary_path(argv[2]) ? write_binary(argv[2], &t) : write_text(argv[2], &t);
+    if (!ok) printf("cannot write %s\n", argv[2]);
+    free_instance(&t);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,421 @@
+/* ======================================================================
+           batch driver for MINKNAP.C
+   ====================================================================== */
+
+/* Instances are taken from a shared source under a lock: from a directory
+ * the next file name, from a stream the next parsed instance. Reading is
+ * cheap compared to solving, so the lock is held only briefly and threads
+ * that finish early simply take more instances.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <dirent.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include "minknap.h"
+#include "batch.h"
+#include "../common/knapsack_binary.h"
+#include "../common/knapsack_text.h"
+
+
+/* ======================================================================
+                platform
+   ====================================================================== */
+
+#ifdef _WIN32
+
+typedef CRITICAL_SECTION lock_t;
+#define lock_init(l)     InitializeCriticalSection(l)
+#define lock_free(l)     DeleteCriticalSection(l)
+#define lock_take(l)     EnterCriticalSection(l)
+#define lock_give(l)     LeaveCriticalSection(l)
+
+typedef HANDLE thread_t;
+
+static DWORD WINAPI thread_entry(LPVOID arg);
+
+static int thread_start(thread_t *t, void *arg)
+{
+    *t = CreateThread(NULL, 0, thread_entry, arg, 0, NULL);
+    return *t != NULL;
+}
+
+static void thread_join(thread_t t)
+{
+    WaitForSingleObject(t, INFINITE);
+    CloseHandle(t);
+}
+
+static int cpu_count(void)
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+}
+
+static double now_ms(void)
+{
+    LARGE_INTEGER f, t;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&t);
+    return 1000.0 * (double)t.QuadPart / (double)f.QuadPart;
+}
+
+static int is_directory(const char *path)
+{
+    DWORD attr = GetFileAttributesA(path);
+    return attr != INVALID_FILE_ATTRIBUTES && (attr & FILE_ATTRIBUTE_DIRECTORY);
+}
+
+#else
+
+typedef pthread_mutex_t lock_t;
+#define lock_init(l)     pthread_mutex_init(l, NULL)
+#define lock_free(l)     pthread_mutex_destroy(l)
+#define lock_take(l)     pthread_mutex_lock(l)
+#define lock_give(l)     pthread_mutex_unlock(l)
+
+typedef pthread_t thread_t;
+
+static void *thread_entry(void *arg);
+
+static int thread_start(thread_t *t, void *arg)
+{
+    return pthread_create(t, NULL, thread_entry, arg) == 0;
+}
+
+static void thread_join(thread_t t)
+{
+    pthread_join(t, NULL);
+}
+
+static int cpu_count(void)
+{
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+static double now_ms(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return 1000.0 * (double)t.tv_sec + (double)t.tv_nsec / 1e6;
+}
+
+static int is_directory(const char *path)
+{
+    struct stat st;
+    return stat(path, &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+#endif
+
+
+/* ======================================================================
+                directory listing
+   ====================================================================== */
+
+typedef struct {
+    char **names;
+    int    count;
+    int    capacity;
+} namelist;
+
+static int add_name(namelist *l, const char *dir, const char *name)
+{
+    size_t len = strlen(dir) + strlen(name) + 2;
+    char *path;
+
+    if (l->count == l->capacity) {
+        int capacity = l->capacity ? 2 * l->capacity : 256;
+        char **names = (char **)realloc(l->names, capacity * sizeof(char *));
+        if (names == NULL) return 0;
+        l->names = names;
+        l->capacity = capacity;
+    }
+    path = (char *)malloc(len);
+    if (path == NULL) return 0;
+    sprintf(path, "%s/%s", dir, name);
+    l->names[l->count++] = path;
+    return 1;
+}
+
+static int compare_names(const void *a, const void *b)
+{
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+/* collects the regular files of dir, sorted so that indices are stable */
+static int list_directory(const char *dir, namelist *l)
+{
+#ifdef _WIN32
+    WIN32_FIND_DATAA data;
+    HANDLE h;
+    char pattern[MAX_PATH];
+
+    _snprintf(pattern, sizeof(pattern), "%s\\*", dir);
+    h = FindFirstFileA(pattern, &data);
+    if (h == INVALID_HANDLE_VALUE) return 0;
+    do {
+        if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) continue;
+        if (!add_name(l, dir, data.cFileName)) { FindClose(h); return 0; }
+    } while (FindNextFileA(h, &data));
+    FindClose(h);
+#else
+    DIR *d;
+    struct dirent *e;
+
+    d = opendir(dir);
+    if (d == NULL) return 0;
+    while ((e = readdir(d)) != NULL) {
+        if (e->d_name[0] == '.') continue;
+        if (!add_name(l, dir, e->d_name)) { closedir(d); return 0; }
+        if (is_directory(l->names[l->count - 1])) free(l->names[--l->count]);
+    }
+    closedir(d);
+#endif
+    qsort(l->names, l->count, sizeof(char *), compare_names);
+    return 1;
+}
+
+
+/* ======================================================================
+                instances
+   ====================================================================== */
+
+typedef struct {
+    int           n;
+    int           capacity;   /* allocated length of p, w and x */
+    minknap_item *p;
+    minknap_item *w;
+    int          *x;
+    minknap_item  c;
+} instance;
+
+static int reserve_instance(instance *t, int n)
+{
+    if (n > t->capacity) {
+        free(t->p); free(t->w); free(t->x);
+        t->p = (minknap_item *)malloc(n * sizeof(minknap_item));
+        t->w = (minknap_item *)malloc(n * sizeof(minknap_item));
+        t->x = (int *)malloc(n * sizeof(int));
+        t->capacity = n;
+        if (t->p == NULL || t->w == NULL || t->x == NULL) {
+            t->capacity = 0;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* reads one instance, returns 1 on success, 0 at end of input and -1 if
+ * the input is malformed or memory runs out */
+static int read_instance(knap_text_reader *in, instance *t)
+{
+    knap_text_info info;
+    int status, n;
+
+    status = knap_text_header(in, &info);
+    if (status == KNAP_END) return 0;
+    if (status != KNAP_OK || info.n > INT_MAX) return -1;
+    n = (int)info.n;
+    if (!reserve_instance(t, n)) return -1;
+    status = knap_text_items(in, &info, 8 * sizeof(minknap_item), t->p, t->w, NULL);
+    if (status != KNAP_OK) return -1;
+    t->n = n;
+    t->c = (minknap_item)info.capacity;
+    memset(t->x, 0, n * sizeof(int));
+    return 1;
+}
+
+/* reads a binary instance file, returns 1 on success and -1 otherwise */
+static int read_binary_instance(const char *path, instance *t)
+{
+    knap_file f;
+    int i, n, ok;
+
+    if (knap_open(path, &f) != KNAP_OK) return -1;
+    n = (int)f.header->n;
+    ok = n >= 1 && reserve_instance(t, n);
+    for (i = 0; ok && i < n; i++) {
+        t->p[i] = (minknap_item)knap_profit(&f, i);
+        t->w[i] = (minknap_item)knap_weight(&f, i);
+        ok = t->p[i] == knap_profit(&f, i) && t->w[i] == knap_weight(&f, i);
+    }
+    if (ok) {
+        t->n = n;
+        t->c = (minknap_item)f.header->capacity;
+        memset(t->x, 0, n * sizeof(int));
+    }
+    knap_close(&f);
+    return ok ? 1 : -1;
+}
+
+
+/* ======================================================================
+                batch
+   ====================================================================== */
+
+typedef struct {
+    lock_t            lock;
+    namelist          files;    /* directory mode */
+    knap_text_reader *stream;   /* stream mode    */
+    int               next;     /* index of the next instance */
+    int               done;     /* stream exhausted */
+    FILE             *results;
+    int               failed;
+} batch;
+
+static void report(batch *b, int index, const char *name, const instance *t,
+                   minknap_sum z, double readMs, double solveMs,
+                   const char *status)
+{
+    lock_take(&b->lock);
+    fprintf(b->results, "%d\t%s\t%d\t%lld\t%lld\t%.3f\t%.3f\t%s\n",
+        index, name, t->n, (long long)t->c, z, readMs, solveMs, status);
+    lock_give(&b->lock);
+}
+
+static void run_worker(batch *b)
+{
+    minknap_workspace *ws;
+    instance t;
+    char name[32];
+    const char *file;
+    int index, status;
+    double start, readMs, solveMs;
+    minknap_sum z;
+
+    memset(&t, 0, sizeof(t));
+    ws = minknap_create();
+
+    for (;;) {
+        /* take the next instance, parsing it while holding the lock when
+         * the instances share one stream */
+        lock_take(&b->lock);
+        if (b->stream != NULL) {
+            if (b->done) { lock_give(&b->lock); break; }
+            start = now_ms();
+            status = read_instance(b->stream, &t);
+            readMs = now_ms() - start;
+            if (status <= 0) b->done = 1;
+            index = status == 0 ? -1 : b->next++;
+            file = NULL;
+        } else {
+            index = b->next < b->files.count ? b->next++ : -1;
+            file = index >= 0 ? b->files.names[index] : NULL;
+            status = 1;
+            readMs = 0;
+        }
+        lock_give(&b->lock);
+        if (index < 0) break;
+
+        if (file != NULL && knap_is_binary_path(file)) {
+            start = now_ms();
+            status = read_binary_instance(file, &t);
+            readMs = now_ms() - start;
+        } else if (file != NULL) {
+            knap_text_reader *in;
+            start = now_ms();
+            in = knap_text_open(file);
+            status = in != NULL ? read_instance(in, &t) : -1;
+            knap_text_close(in);
+            readMs = now_ms() - start;
+        } else {
+            sprintf(name, "#%d", index);
+        }
+
+        z = -1;
+        solveMs = 0;
+        if (status <= 0) {
+            t.n = 0; t.c = 0;
+            status = MINKNAP_ERR_ARGS;
+            report(b, index, file ? file : name, &t, z, readMs, solveMs, "unreadable");
+        } else {
+            start = now_ms();
+            status = ws == NULL ? MINKNAP_ERR_NOMEM :
+                minknap_solve(ws, t.n, t.p, t.w, t.x, t.c, &z);
+            solveMs = now_ms() - start;
+            report(b, index, file ? file : name, &t, z, readMs, solveMs,
+                status == MINKNAP_OK ? "ok" :
+                ws != NULL && minknap_error(ws) != NULL ? minknap_error(ws) : "failed");
+        }
+        if (status != MINKNAP_OK) {
+            lock_take(&b->lock);
+            b->failed++;
+            lock_give(&b->lock);
+        }
+    }
+
+    minknap_destroy(ws);
+    free(t.p); free(t.w); free(t.x);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI thread_entry(LPVOID arg)
+{
+    run_worker((batch *)arg);
+    return 0;
+}
+#else
+static void *thread_entry(void *arg)
+{
+    run_worker((batch *)arg);
+    return NULL;
+}
+#endif
+
+int minknap_batch(const char *source, int numThreads, const char *results)
+{
+    batch b;
+    thread_t *threads;
+    int i, started;
+
+    memset(&b, 0, sizeof(b));
+    if (is_directory(source)) {
+        if (!list_directory(source, &b.files)) return -1;
+    } else {
+        b.stream = knap_text_open(source);
+        if (b.stream == NULL) return -1;
+    }
+    b.results = fopen(results, "w");
+    if (b.results == NULL) {
+        knap_text_close(b.stream);
+        return -1;
+    }
+    fprintf(b.results, "index\tname\tn\tc\tz\tread_ms\tsolve_ms\tstatus\n");
+    lock_init(&b.lock);
+
+    if (numThreads < 1) numThreads = cpu_count();
+    threads = (thread_t *)malloc(numThreads * sizeof(thread_t));
+    started = 0;
+    if (threads != NULL) {
+        for (i = 0; i < numThreads; i++) {
+            if (!thread_start(&threads[started], &b)) break;
+            started++;
+        }
+    }
+    if (started == 0) run_worker(&b);
+    for (i = 0; i < started; i++) thread_join(threads[i]);
+    free(threads);
+
+    lock_free(&b.lock);
+    fclose(b.results);
+    knap_text_close(b.stream);
+    for (i = 0; i < b.files.count; i++) free(b.files.names[i]);
+    free(b.files.names);
+
+    return b.failed;
+}
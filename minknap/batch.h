@@ -0,0 +1,36 @@
+/* ======================================================================
+           BATCH.H, batch driver for MINKNAP.C
+   ====================================================================== */
+
+/* Solves many instances in one process:
+ *
+ *   minknap -b source [threads [results]]
+ *
+ * source is either a directory, in which every file holds one instance,
+ * or a file with instances written one after another. Each instance has
+ * the layout of "test.in": the number of items, one "i p w" line per
+ * item, and the capacity; ".kbin" files in a directory are read in the
+ * binary format of knapsack_binary.h instead. Instances are handed out
+ * to threads one at a time, every thread solving with its own workspace.
+ * One tab separated line per instance is written to results
+ * ("results.tsv" by default):
+ *
+ *   index  name  n  c  z  read_ms  solve_ms  status
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* runs the batch, returns the number of instances that failed or -1 if
+ * the source or the results file could not be opened */
+int minknap_batch(const char *source, int numThreads, const char *results);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
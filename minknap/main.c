@@ -0,0 +1,228 @@
+/* ======================================================================
+           driver for MINKNAP.C
+   ====================================================================== */
+
+/* Reads the instance from "test.in", solves it with the capacity given
+ * on the command line and writes the solution to "test.out":
+ *
+ *   minknap c [input [output [incumbent]]]
+ *
+ * input and output default to "test.in" and "test.out"; files ending in
+ * ".kbin" are read and written in the binary format of knapsack_binary.h,
+ * where a binary input with 32-bit items is solved in place. incumbent is
+ * a solution in the test.out layout, e.g. written by tabusearch, which the
+ * search starts from. Or solves many instances in one run, see batch.h:
+ *
+ *   minknap -b source [threads [results]]
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "minknap.h"
+#include "batch.h"
+#include "../common/knapsack_binary.h"
+#include "../common/knapsack_text.h"
+
+
+/* ======================================================================
+                binary files
+====================================================================== */
+
+/* maps a binary instance, p and w point into the mapping when the item
+ * widths agree and into owned copies otherwise */
+static int load_binary(const char* path, knap_file* f, int* len,
+                       minknap_item** p, minknap_item** w, int* owned)
+{
+    if (knap_open(path, f) != KNAP_OK) return 0;
+    *len = (int)f->header->n;
+    if (f->header->itembits == 8 * sizeof(minknap_item))
+    {
+        *p = (minknap_item*)f->p;
+        *w = (minknap_item*)f->w;
+        *owned = 0;
+        return 1;
+    }
+    *p = (minknap_item*)malloc(*len * sizeof(minknap_item));
+    *w = (minknap_item*)malloc(*len * sizeof(minknap_item));
+    *owned = 1;
+    for (int i = 0; i < *len && *p != NULL && *w != NULL; i++)
+    {
+        (*p)[i] = (minknap_item)knap_profit(f, i);
+        (*w)[i] = (minknap_item)knap_weight(f, i);
+        if ((*p)[i] != knap_profit(f, i) || (*w)[i] != knap_weight(f, i)) return 0;
+    }
+    return *p != NULL && *w != NULL;
+}
+
+static int save_binary(const char* path, int len, minknap_item* p, minknap_item* w,
+                       int* x, minknap_item c, minknap_sum z)
+{
+    knap_header h;
+    uint64_t* bits = (uint64_t*)calloc((len + 63) / 64 + 1, sizeof(uint64_t));
+    int status;
+
+    if (bits == NULL) return KNAP_ERR_WRITE;
+    for (int i = 0; i < len; i++)
+    {
+        if (x[i]) bits[i / 64] |= (uint64_t)1 << (i % 64);
+    }
+    knap_init_header(&h, len, 8 * sizeof(minknap_item), c, z, 1);
+    status = knap_write(path, &h, p, w, bits);
+    free(bits);
+    return status;
+}
+
+
+/* ======================================================================
+                incumbent
+====================================================================== */
+
+/* reads the solution of a file in the test.out layout into x0, which
+ * holds len values; the items themselves aren't checked */
+static int load_incumbent(const char* path, int len, int* x0)
+{
+    knap_text_reader* r = knap_text_open(path);
+    knap_text_info info;
+    minknap_item *p = NULL, *w = NULL;
+    uint64_t* bits = NULL;
+    int ok = r != NULL && knap_text_header(r, &info) == KNAP_OK &&
+        info.withSolution && info.n == len;
+    if (ok)
+    {
+        p = (minknap_item*)malloc(len * sizeof(minknap_item));
+        w = (minknap_item*)malloc(len * sizeof(minknap_item));
+        bits = (uint64_t*)calloc((len + 63) / 64, sizeof(uint64_t));
+        ok = p != NULL && w != NULL && bits != NULL &&
+            knap_text_items(r, &info, 8 * sizeof(minknap_item), p, w, bits) == KNAP_OK;
+    }
+    for (int i = 0; ok && i < len; i++)
+        x0[i] = (int)((bits[i / 64] >> (i % 64)) & 1);
+    free(p);
+    free(w);
+    free(bits);
+    knap_text_close(r);
+    return ok;
+}
+
+
+/* ======================================================================
+                main
+====================================================================== */
+
+int main(int argc, char* argv[])
+{
+    int len = 0;
+
+    minknap_item* p = 0;
+    minknap_item* w = 0;
+    int* x = 0;
+    minknap_item c = 0;
+    if (argc >= 3 && strcmp(argv[1], "-b") == 0) {
+        int numThreads = argc >= 4 ? atoi(argv[3]) : 0;
+        const char* results = argc >= 5 ? argv[4] : "results.tsv";
+        int failed = minknap_batch(argv[2], numThreads, results);
+        if (failed < 0)
+        {
+            printf("cannot open %s or %s\n", argv[2], results);
+            return 1;
+        }
+        if (failed > 0) printf("%d instances failed\n", failed);
+        return failed > 0;
+    }
+    if (argc >= 2 && argc <= 5) {
+        const char* input = argc >= 3 ? argv[2] : "test.in";
+        const char* output = argc >= 4 ? argv[3] : "test.out";
+        knap_file f;
+        int owned = 1;
+
+        c = (minknap_item)strtoll(argv[1], NULL, 10);
+        memset(&f, 0, sizeof(f));
+        if (knap_is_binary_path(input))
+        {
+            if (!load_binary(input, &f, &len, &p, &w, &owned))
+            {
+                printf("cannot read %s\n", input);
+                return 1;
+            }
+        }
+        else
+        {
+            knap_text_reader* r = knap_text_open(input);
+            knap_text_info info;
+            int status = r == NULL ? KNAP_ERR_OPEN : knap_text_header(r, &info);
+            if (status == KNAP_OK)
+            {
+                len = (int)info.n;
+                p = (minknap_item*)malloc(len * sizeof(minknap_item));
+                w = (minknap_item*)malloc(len * sizeof(minknap_item));
+                status = p == NULL || w == NULL ? KNAP_ERR_OPEN :
+                    knap_text_items(r, &info, 8 * sizeof(minknap_item), p, w, NULL);
+            }
+            if (status != KNAP_OK)
+            {
+                printf("cannot read %s: %s\n", input, r != NULL ? knap_text_error(r) : "");
+                knap_text_close(r);
+                return 1;
+            }
+            knap_text_close(r);
+        }
+
+        x = (int*)malloc(len * sizeof(int));
+        memset(x, 0, len * sizeof(int));
+
+        minknap_sum z0 = 0;
+        if (argc >= 5)
+        {
+            if (!load_incumbent(argv[4], len, x))
+            {
+                printf("cannot read the solution of %d items from %s\n", len, argv[4]);
+                return 1;
+            }
+            for (int i = 0; i < len; i++)
+            {
+                if (x[i]) z0 += p[i];
+            }
+        }
+
+        minknap_workspace* ws = minknap_create();
+        minknap_sum z = 0;
+        int status = ws == NULL ? MINKNAP_ERR_NOMEM :
+            argc >= 5 ? minknap_solve_warm(ws, len, p, w, x, c, x, z0, &z) :
+            minknap_solve(ws, len, p, w, x, c, &z);
+        if (status != MINKNAP_OK)
+        {
+            printf("minknap failed (%d): %s\n", status,
+                ws != NULL && minknap_error(ws) != NULL ? minknap_error(ws) : "");
+            minknap_destroy(ws);
+            return 1;
+        }
+        minknap_destroy(ws);
+
+        if (knap_is_binary_path(output))
+        {
+            if (save_binary(output, len, p, w, x, c, z) != KNAP_OK)
+                printf("cannot write %s\n", output);
+        }
+        else
+        {
+            FILE* out = fopen(output, "w");
+            if (out != NULL)
+            {
+                fprintf(out, "%5d     C     W\n", len);
+                for (int i = 0; i < len; i++) {
+                    fprintf(out, "%5d %5lld %5lld %5d\n", i, (long long)p[i], (long long)w[i], x[i]);
+                }
+                fprintf(out, "%lld\n", (long long)c);
+                fprintf(out, "%lld\n", z);
+                fclose(out);
+            }
+        }
+        if (owned) { free(p); free(w); }
+        free(x);
+        knap_close(&f);
+    }
+
+    return 0;
+}
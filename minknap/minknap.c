@@ -33,18 +33,28 @@
  * 
  * where p[], w[], x[] are arrays of integers. The optimal objective
  * value is returned in z, and x[] gives the solution vector.
+ * The reentrant library interface declared in minknap.h solves the
+ * problem within a caller owned workspace and returns status codes
+ * instead of terminating the process.
  * If you need a different interface for your algorithm, minknap
  * may easily be adapted to your own datastructures since all tables
  * are copied to the internal representation. 
  *
- * Since the minknap algorithm is based on dynamic programming, you
- * must give an upper limit MAXSTATES on the number of states. The 
- * constant is defined below. Different types should be defined as
- * follows:
+ * Since the minknap algorithm is based on dynamic programming, it
+ * keeps a set of states. The set starts with INITSTATES records and
+ * grows geometrically whenever a multiplication needs more space; the
+ * grown set is kept in the workspace for later iterations and calls.
+ * Different types should be defined as follows:
  * 
  *    itype     should be sufficiently large to hold a profit or weight
  *    stype     should be sufficient to hold sum of profits/weights
  *    ptype     should hold the product of an stype and itype
+ *
+ * itype and stype follow minknap_item and minknap_sum from minknap.h,
+ * which are 32/64 bit or 64/64 bit depending on MINKNAP_ITEM_BITS.
+ * ptype is a 128-bit integer where the compiler has one, so that all
+ * bound tests with DET are exact; without it only 32-bit items are
+ * supported and products fall back to double.
  * 
  * The code has been tested on a hp9000/735, and conforms with the
  * ANSI-C standard. 
@@ -64,7 +74,7 @@
                                   definitions
    ====================================================================== */
 
-#define MAXSTATES 400000 
+#define INITSTATES 1024  /* initial size of the set of states */
 
 #include <stdlib.h>
 #include <stdio.h>
@@ -73,7 +83,9 @@
 //#include <values.h>
 #include <string.h>
 #include <math.h>
-#include <malloc.h>
+#include <setjmp.h>
+
+#include "minknap.h"
 
 
 /* ======================================================================
@@ -100,6 +112,7 @@
 #define WMIN 1                 /* weight of worlds least efficient item */
 
 #define DET(a1, a2, b1, b2)    ((a1) * (ptype) (b2) - (a2) * (ptype) (b1))
+#define ABS(a)                 ((a) < 0 ? -(a) : (a))
 #define SWAP(a, b)   { register item t; t = *(a); *(a) = *(b); *(b) = t; }
 #define DIFF(a,b)              ((int) ((b)-(a)+1))
 #define NO(a,p)                ((int) ((p) - (a)->fitem + 1))
@@ -114,9 +127,15 @@
 
 typedef int           boolean;
 typedef long          ntype;   /* number of states/items   */
-typedef long          itype;   /* item profits and weights */
-typedef long          stype;   /* sum of pofit or weight   */
+typedef minknap_item  itype;   /* item profits and weights */
+typedef minknap_sum   stype;   /* sum of pofit or weight   */
+#if defined(__SIZEOF_INT128__)
+typedef __int128      ptype;   /* product type (exact)     */
+#elif MINKNAP_ITEM_BITS == 32
 typedef double        ptype;   /* product type (sufficient precision) */
+#else
+#error "64-bit items need a 128-bit integer type for exact products"
+#endif
 typedef unsigned long btype;   /* binary representation of solution */
 
 /* item record */
@@ -192,45 +211,31 @@ typedef struct { /* all problem information */
   long     maxstates;
   long     coresize;
   long     bzcore;
-} allinfo;
 
+  minknap_workspace *work;  /* buffers owned by the caller */
+  jmp_buf  env;             /* where errors return to      */
+} allinfo;
 
-/* ======================================================================
-				  errorx
-   ====================================================================== */
-
-void errorx(char *str, ...)
-{
-  va_list args;
-
-  va_start(args, str);
-  vprintf(str, args); printf("\n");
-  va_end(args);
-  printf("Program is terminated !!!\n\n");
-  exit(-1);
-}
+/* buffers reused by all calls with the same workspace */
+struct minknap_workspace {
+  item     *tab;            /* internal copy of the items  */
+  ntype    tabsize;
+  interval *inttab;         /* interval stack              */
+  state    *states;         /* dynamic programming states  */
+  ntype    statesize;       /* number of allocated states  */
+  const char *error;        /* description of last error   */
+};
 
 
 /* ======================================================================
-				  palloc
+				  errorx
    ====================================================================== */
 
-void pfree(void *p)
-{
-  if (p == NULL) errorx("freeing null");
-  free(p);
-}
-
-
-void *palloc(long size)
+static void errorx(allinfo *a, int code, const char *str)
 {
-  char *p;
-
-  if (size == 0) size = 1;
-  if (size != (size_t) size) errorx("Alloc too big %ld", size);
-  p = malloc(size);
-  if (p == NULL) errorx("no memory size %ld", size);
-  return p;
+  /* unwind to minknap_solve, which returns the code */
+  a->work->error = str;
+  longjmp(a->env, code);
 }
 
 
@@ -238,13 +243,13 @@ void *palloc(long size)
 				  findvect
    ====================================================================== */
 
-state *findvect(stype ws, state *f, state *l)
+static state *findvect(allinfo *a, stype ws, state *f, state *l)
 {
   /* find vector i, so that i->wsum <= ws < (i+1)->wsum */
   register state *m;
 
   /* a set should always have at least one vector */
-  if (f > l) errorx("findvect: empty set");
+  if (f > l) errorx(a, MINKNAP_ERR_INTERNAL, "findvect: empty set");
   if (f->wsum >  ws) return NULL;
   if (l->wsum <= ws) return l;
 
@@ -261,24 +266,24 @@ state *findvect(stype ws, state *f, state *l)
 				push/pop
    ====================================================================== */
 
-void push(allinfo *a, int side, item *f, item *l)
+static void push(allinfo *a, int side, item *f, item *l)
 {
   interval *pos=0;
   switch (side) {
     case LEFT : pos = a->intv1; (a->intv1)++; break;
     case RIGHT: pos = a->intv2; (a->intv2)--; break;
   }
-  if (a->intv1 == a->intv2) errorx("interval stack full");
+  if (a->intv1 == a->intv2) errorx(a, MINKNAP_ERR_INTERNAL, "interval stack full");
   pos->f = f; pos->l = l;
 }
 
-void pop(allinfo *a, int side, item **f, item **l)
+static void pop(allinfo *a, int side, item **f, item **l)
 {
   interval *pos=0;
   switch (side) {
-    case LEFT : if (a->intv1 == a->intv1b) errorx("pop left");
+    case LEFT : if (a->intv1 == a->intv1b) errorx(a, MINKNAP_ERR_INTERNAL, "pop left");
 		(a->intv1)--; pos = a->intv1; break;
-    case RIGHT: if (a->intv2 == a->intv2b) errorx("pop right");
+    case RIGHT: if (a->intv2 == a->intv2b) errorx(a, MINKNAP_ERR_INTERNAL, "pop right");
 		(a->intv2)++; pos = a->intv2; break;
   }
   *f = pos->f; *l = pos->l;
@@ -289,10 +294,10 @@ void pop(allinfo *a, int side, item **f, item **l)
 				improvesolution
    ====================================================================== */
 
-void improvesolution(allinfo *a, state *v)
+static void improvesolution(allinfo *a, state *v)
 {
-  if (v->wsum  > a->c) errorx("wrong improvesoluton");
-  if (v->psum <= a->z) errorx("not improved solution");
+  if (v->wsum  > a->c) errorx(a, MINKNAP_ERR_INTERNAL, "wrong improvesoluton");
+  if (v->psum <= a->z) errorx(a, MINKNAP_ERR_INTERNAL, "not improved solution");
 
   a->z      = v->psum;
   a->zwsum  = v->wsum;
@@ -305,7 +310,7 @@ void improvesolution(allinfo *a, state *v)
 				definesolution
    ====================================================================== */
 
-void definesolution(allinfo *a)
+static void definesolution(allinfo *a)
 {
   register item *f, *l, *i;
   register stype psum, wsum;
@@ -353,15 +358,15 @@ void definesolution(allinfo *a)
 				median
    ====================================================================== */
 
-item *median(item *f1, item *l1, ntype s)
+static item *median(item *f1, item *l1, ntype s, item *r)
 {
   /* Find median r of items [f1, f1+s, f1+2s, ... l1], */
   /* and ensure the ordering f1 >= r >= l1.            */
+  /* The median is copied to the record r given by the caller. */
   register ptype mp, mw;
   register item *i, *j;
   register item *f, *l, *k, *m, *q;
   ntype n, d;
-  static item r;
 
   n = (l1 - f1) / s;              /* number of values      */
   f = f1;                         /* calculated first item */
@@ -382,9 +387,9 @@ item *median(item *f1, item *l1, ntype s)
 	}
       }
     }
-    if (d <= 3) { r = *q; break; }
+    if (d <= 3) { *r = *q; break; }
 
-    r.p = mp = m->p; r.w = mw = m->w; i = f; j = l;
+    r->p = mp = m->p; r->w = mw = m->w; i = f; j = l;
     for (;;) {
       do { i += s; } while (DET(i->p, i->w, mp, mw) > 0);
       do { j -= s; } while (DET(j->p, j->w, mp, mw) < 0);
@@ -396,7 +401,7 @@ item *median(item *f1, item *l1, ntype s)
     if (i > q) l = j; else f = i;    
   }
   SWAP(k, l1);
-  return &r;
+  return r;
 }
 
 
@@ -404,17 +409,18 @@ item *median(item *f1, item *l1, ntype s)
 				partsort
    ====================================================================== */
 
-void partsort(allinfo *a, item *f, item *l, stype ws, int what)
+static void partsort(allinfo *a, item *f, item *l, stype ws, int what)
 {
   register ptype mp, mw;
   register item *i=0, *j=0, *m=0;
   register stype wi;
   register int d;
+  item r;
 
   d = l - f + 1;
-  if (d < 1) errorx("negative interval in partsort");
+  if (d < 1) errorx(a, MINKNAP_ERR_INTERNAL, "negative interval in partsort");
   if (d > MINMED) {
-    m = median(f, l, (int) sqrt(d));
+    m = median(f, l, (int) sqrt(d), &r);
   } else {
     if (d > 1) {
       m = f + d / 2;
@@ -458,7 +464,7 @@ void partsort(allinfo *a, item *f, item *l, stype ws, int what)
 				  haschance
    ====================================================================== */
 
-boolean haschance(allinfo *a, item *i, int side)
+static boolean haschance(allinfo *a, item *i, int side)
 {
   register state *j, *m;
   register ptype p, w, r;
@@ -488,11 +494,41 @@ boolean haschance(allinfo *a, item *i, int side)
 }
 
 
+/* ======================================================================
+				  growstates
+   ====================================================================== */
+
+static void growstates(allinfo *a, ntype need)
+{
+  /* the set [fset, lset] is kept at the top of the array, with one spare */
+  /* record above it, so it is moved to the top of the enlarged array.   */
+  minknap_workspace *ws;
+  ntype size, n, first;
+  state *set1;
+
+  ws = a->work;
+  size = ws->statesize;
+  while (size < need) size *= 2;
+  n = a->d.size;
+  first = a->d.fset - a->d.set1;
+  set1 = (state *) realloc(ws->states, sizeof(state) * size);
+  if (set1 == NULL) errorx(a, MINKNAP_ERR_NOMEM, "no memory for states");
+
+  memmove(set1 + size - 1 - n, set1 + first, sizeof(state) * n);
+  ws->states    = set1;
+  ws->statesize = size;
+  a->d.set1 = set1;
+  a->d.setm = set1 + size - 1;
+  a->d.fset = a->d.setm - n;
+  a->d.lset = a->d.setm - 1;
+}
+
+
 /* ======================================================================
 				  multiply
    ====================================================================== */
 
-void multiply(allinfo *a, item *h, int side)
+static void multiply(allinfo *a, item *h, int side)
 {
   register state *i, *j, *k, *m;
   register itype p, w;
@@ -501,7 +537,7 @@ void multiply(allinfo *a, item *h, int side)
 
   if (a->d.size == 0) return;
   if (side == RIGHT) { p = h->p; w = h->w; } else { p = -h->p; w = -h->w; }
-  if (2*a->d.size + 2 > MAXSTATES) errorx("no space in multiply");
+  if (2*a->d.size + 2 > a->d.setm - a->d.set1 + 1) growstates(a, 2*a->d.size + 2);
 
   /* keep track on solution vector */
   a->vno++;
@@ -513,8 +549,8 @@ void multiply(allinfo *a, item *h, int side)
   /* initialize limits */
   r1 = a->d.fset; rm = a->d.lset; k = a->d.set1; m = rm + 1;
   k->psum = -1;
-  k->wsum = r1->wsum + abs(p) + 1;
-  m->wsum = rm->wsum + abs(w) + 1;
+  k->wsum = r1->wsum + ABS(p) + 1;
+  m->wsum = rm->wsum + ABS(w) + 1;
 
   for (i = r1, j = r1; (i != m) || (j != m); ) {
     if (i->wsum <= j->wsum + w) {
@@ -546,7 +582,7 @@ void multiply(allinfo *a, item *h, int side)
 				   simpreduce
    ========================================================================= */
 
-void simpreduce(int side, item **f, item **l, allinfo *a)
+static void simpreduce(int side, item **f, item **l, allinfo *a)
 {
   register item *i, *j, *k;
   register ptype pb, wb;
@@ -590,7 +626,7 @@ void simpreduce(int side, item **f, item **l, allinfo *a)
 				  reduceset
    ====================================================================== */
 
-void reduceset(allinfo *a)
+static void reduceset(allinfo *a)
 {
   register state *i, *m, *k;
   register ptype ps, ws, pt, wt, r;
@@ -602,7 +638,7 @@ void reduceset(allinfo *a)
 
   /* initialize limits */
   r1 = a->d.fset; rm = a->d.lset;
-  v  = findvect(a->c, r1, rm);
+  v  = findvect(a, a->c, r1, rm);
   if (v == NULL) v = r1 - 1; /* all states infeasible */ 
   else { if (v->psum > a->z) improvesolution(a, v); }
 
@@ -671,13 +707,13 @@ void reduceset(allinfo *a)
 				  initfirst
    ====================================================================== */
 
-void initfirst(allinfo *a, stype ps, stype ws)
+static void initfirst(allinfo *a, stype ps, stype ws)
 {
   register state *k;
 
   a->d.size  = 1;
-  a->d.set1  = palloc(MAXSTATES * sizeof(state));
-  a->d.setm  = a->d.set1 + MAXSTATES - 1;
+  a->d.set1  = a->work->states;
+  a->d.setm  = a->d.set1 + a->work->statesize - 1;
   a->d.fset  = a->d.set1;
   a->d.lset  = a->d.set1;
 
@@ -692,7 +728,7 @@ void initfirst(allinfo *a, stype ps, stype ws)
 				  initvect
    ====================================================================== */
 
-void initvect(allinfo *a)
+static void initvect(allinfo *a)
 {
   register btype i;
   for (i = 0; i < MAXV; i++) a->vitem[i] = NULL;
@@ -704,10 +740,11 @@ void initvect(allinfo *a)
 				  copyproblem
    ====================================================================== */
 
-void copyproblem(item *f, item *l, int *p, int *w, int *x)
+static void copyproblem(item *f, item *l, itype *p, itype *w, int *x)
 {
   register item *i, *m;
-  register int *pp, *ww, *xx;
+  register itype *pp, *ww;
+  register int *xx;
 
   for (i = f, m = l+1, pp = p, ww = w, xx = x; i != m; i++, pp++, ww++, xx++) {
     i->p = *pp; i->w = *ww; i->x = xx; 
@@ -719,7 +756,7 @@ void copyproblem(item *f, item *l, int *p, int *w, int *x)
 				findbreak
    ====================================================================== */
 
-void findbreak(allinfo *a)
+static void findbreak(allinfo *a)
 {
   register item *i, *m;
   register stype psum, wsum, c, r;
@@ -751,19 +788,93 @@ void findbreak(allinfo *a)
 }
 
 
+/* ======================================================================
+				workspace
+   ====================================================================== */
+
+minknap_workspace *minknap_create(void)
+{
+  minknap_workspace *ws;
+
+  ws = (minknap_workspace *) malloc(sizeof(minknap_workspace));
+  if (ws == NULL) return NULL;
+  ws->tab     = NULL;
+  ws->tabsize = 0;
+  ws->inttab  = (interval *) malloc(sizeof(interval) * SORTSTACK);
+  ws->states  = (state *) malloc(sizeof(state) * INITSTATES);
+  ws->statesize = INITSTATES;
+  ws->error   = NULL;
+  if ((ws->inttab == NULL) || (ws->states == NULL)) {
+    minknap_destroy(ws);
+    return NULL;
+  }
+  return ws;
+}
+
+
+void minknap_destroy(minknap_workspace *ws)
+{
+  if (ws == NULL) return;
+  free(ws->tab);
+  free(ws->inttab);
+  free(ws->states);
+  free(ws);
+}
+
+
+const char *minknap_error(const minknap_workspace *ws)
+{
+  return ws->error;
+}
+
+
+static int reserveitems(minknap_workspace *ws, ntype n)
+{
+  item *tab;
+
+  if (n <= ws->tabsize) return MINKNAP_OK;
+  tab = (item *) realloc(ws->tab, sizeof(item) * n);
+  if (tab == NULL) { ws->error = "no memory for items"; return MINKNAP_ERR_NOMEM; }
+  ws->tab = tab;
+  ws->tabsize = n;
+  return MINKNAP_OK;
+}
+
+
 /* ======================================================================
 				minknap
    ====================================================================== */
 
-stype minknap(int n, int *p, int *w, int *x, int c)
+/* z0 is the value of a known solution, or 0 if there's none */
+static int solveproblem(minknap_workspace *ws, int n, minknap_item *p,
+                        minknap_item *w, int *x, minknap_item c,
+                        minknap_sum z0, minknap_sum *z)
 {
   allinfo a;
-  item *tab;
-  interval *inttab;
+  stype psum, wsum;
+  int status, j;
+
+  if ((ws == NULL) || (n < 1) || (c < 0) || (z == NULL)) return MINKNAP_ERR_ARGS;
+  ws->error = NULL;
+
+  /* findbreak() needs an item which doesn't fit */
+  psum = 0; wsum = 0;
+  for (j = 0; j < n; j++) { psum += p[j]; wsum += w[j]; }
+  if (wsum <= c) {
+    for (j = 0; j < n; j++) x[j] = 1;
+    *z = psum;
+    return MINKNAP_OK;
+  }
+  status = reserveitems(ws, n);
+  if (status != MINKNAP_OK) return status;
+
+  /* errorx() jumps back here, everything allocated belongs to ws */
+  status = setjmp(a.env);
+  if (status != 0) return status;
 
   /* allocate space for internal representation */
-  tab = (item *) palloc(sizeof(item) * n);
-  a.fitem = &tab[0]; a.litem = &tab[n-1];
+  a.work  = ws;
+  a.fitem = &ws->tab[0]; a.litem = &ws->tab[n-1];
   copyproblem(a.fitem, a.litem, p, w, x);
   a.n           = n;
   a.cstar       = c;
@@ -775,13 +886,17 @@ stype minknap(int n, int *p, int *w, int *x, int c)
   a.maxstates   = 0;
   a.coresize    = 0;
 
-  inttab  = palloc(sizeof(interval) * SORTSTACK);
-  a.intv1 = a.intv1b = &inttab[0];
-  a.intv2 = a.intv2b = &inttab[SORTSTACK - 1];
+  a.intv1 = a.intv1b = &ws->inttab[0];
+  a.intv2 = a.intv2b = &ws->inttab[SORTSTACK - 1];
   a.fsort = a.litem; a.lsort = a.fitem;
   partsort(&a, a.fitem, a.litem, 0, PARTIATE);
   findbreak(&a);
 
+  /* a better incumbent than the greedy solution tightens the bound tests
+   * of haschance() and reduceset(); the search still has to find a
+   * solution of value z0 or more, which defines the solution vector */
+  if (z0 - 1 > a.z) a.z = z0 - 1;
+
   a.ub        = a.dantzig;
   a.firsttime = TRUE;
 
@@ -806,70 +921,119 @@ stype minknap(int n, int *p, int *w, int *x, int c)
       }
       reduceset(&a);
     }
-    pfree(a.d.set1);
 
     definesolution(&a);
     if (a.welldef) break;
   }
-  pfree(tab);
-  pfree(inttab);
-  return a.zstar;
+  *z = a.zstar;
+  return MINKNAP_OK;
 }
 
 
-/* ======================================================================
-				end
-   ====================================================================== */
+int minknap_solve(minknap_workspace *ws, int n, minknap_item *p,
+                  minknap_item *w, int *x, minknap_item c, minknap_sum *z)
+{
+  return solveproblem(ws, n, p, w, x, c, 0, z);
+}
+
+
+int minknap_solve_warm(minknap_workspace *ws, int n, minknap_item *p,
+                       minknap_item *w, int *x, minknap_item c,
+                       const int *x0, minknap_sum z0, minknap_sum *z)
+{
+  minknap_sum psum, wsum;
+  int j;
+
+  if ((ws == NULL) || (n < 1) || (x0 == NULL)) return MINKNAP_ERR_ARGS;
+  ws->error = NULL;
+
+  /* x0 is read before x is written, so they may be the same array */
+  psum = 0; wsum = 0;
+  for (j = 0; j < n; j++) {
+    if (x0[j]) { psum += p[j]; wsum += w[j]; }
+  }
+  if ((wsum > c) || (psum != z0)) {
+    ws->error = "the incumbent is infeasible or its value is wrong";
+    return MINKNAP_ERR_ARGS;
+  }
+  return solveproblem(ws, n, p, w, x, c, z0, z);
+}
+
 
 /* ======================================================================
-                main
-====================================================================== */
+				minknap_break
+   ====================================================================== */
 
-void main(int argc, char* argv[])
+int minknap_break(minknap_workspace *ws, int n, minknap_item *p,
+                  minknap_item *w, int *x, minknap_item c,
+                  minknap_bound *bound)
 {
-    stype ps, ws;
-    FILE* in;
-
-    int len;
-
-    int* p = 0;
-    int* w = 0;
-    int* x = 0;
-    int c = 0;
-    if (argc == 2) {
-        c = atoi(argv[1]);
-        in = fopen("test.in", "r");
-        if (in != NULL)
-        {
-            fscanf(in, "%d\n", &len);
-            p = (int*)malloc(len * sizeof(int));
-            w = (int*)malloc(len * sizeof(int));
-
-            for (int i = 0; i < len; i++)
-            {
-                int n = 0;
-                fscanf(in, "%d %d %d\n", &n, &p[i], &w[i]);
-            }
-            fclose(in);
-        }
+  allinfo a;
+  register item *i, *m;
+  register stype psum, wsum, r;
+  int status, j;
+
+  if ((ws == NULL) || (n < 1) || (c < 0) || (bound == NULL)) return MINKNAP_ERR_ARGS;
+  ws->error = NULL;
+
+  /* findbreak() needs an item which doesn't fit */
+  psum = 0; wsum = 0;
+  for (j = 0; j < n; j++) { psum += p[j]; wsum += w[j]; }
+  if (wsum <= c) {
+    for (j = 0; j < n; j++) x[j] = 1;
+    bound->b = -1; bound->pb = 0; bound->wb = 0;
+    bound->psumb = psum; bound->wsumb = wsum;
+    bound->dantzig = psum; bound->greedy = psum;
+    return MINKNAP_OK;
+  }
 
-        x = (int*)malloc(len * sizeof(int));
-        memset(x, 0, len * sizeof(int));
-
-        int z = minknap(len, p, w, x, c);
-
-        FILE* out = fopen("test.out", "w");
-        if (out != NULL)
-        {
-            fprintf(out, "%5d     C     W\n", len);
-            for (int i = 0; i < len; i++) {
-                fprintf(out, "%5d %5d %5d %5d\n", i, p[i], w[i], x[i]);
-            }
-            fprintf(out, "%d\n", c);
-            fprintf(out, "%d\n", z);
-            fclose(out);
-        }
-    }
+  status = reserveitems(ws, n);
+  if (status != MINKNAP_OK) return status;
+  status = setjmp(a.env);
+  if (status != 0) return status;
+
+  a.work  = ws;
+  a.fitem = &ws->tab[0]; a.litem = &ws->tab[n-1];
+  copyproblem(a.fitem, a.litem, p, w, x);
+  a.n     = n;
+  a.cstar = c;
+  a.intv1 = a.intv1b = &ws->inttab[0];
+  a.intv2 = a.intv2b = &ws->inttab[SORTSTACK - 1];
+  a.fsort = a.litem; a.lsort = a.fitem;
+  partsort(&a, a.fitem, a.litem, 0, PARTIATE);
+  findbreak(&a);
 
+  /* findbreak() leaves only the items before the break in x */
+  r = c - a.wsumb;
+  for (i = a.b, m = a.litem; i <= m; i++) {
+    if (i->w <= r) { *(i->x) = 1; r -= i->w; }
+  }
+
+  bound->b       = (int) (a.b->x - x);
+  bound->pb      = a.b->p;
+  bound->wb      = a.b->w;
+  bound->psumb   = a.psumb;
+  bound->wsumb   = a.wsumb;
+  bound->dantzig = a.dantzig;
+  bound->greedy  = a.z + 1;
+  return MINKNAP_OK;
+}
+
+
+minknap_sum minknap(int n, minknap_item *p, minknap_item *w, int *x,
+                    minknap_item c)
+{
+  minknap_workspace *ws;
+  minknap_sum z;
+
+  ws = minknap_create();
+  if (ws == NULL) return -1;
+  if (minknap_solve(ws, n, p, w, x, c, &z) != MINKNAP_OK) z = -1;
+  minknap_destroy(ws);
+  return z;
 }
 
+
+/* ======================================================================
+				end
+   ====================================================================== */
@@ -0,0 +1,95 @@
+/* ======================================================================
+           MINKNAP.H, library interface of MINKNAP.C
+   ====================================================================== */
+
+/* The solver keeps no global or static state. Everything it allocates
+ * lives in a workspace owned by the caller, which is reused by all the
+ * calls made with it, so independent instances may be solved concurrently
+ * as long as every thread uses its own workspace.
+ *
+ *          ws = minknap_create();
+ *          status = minknap_solve(ws, n, p, w, x, c, &z);
+ *          ...
+ *          minknap_destroy(ws);
+ *
+ * Errors are reported as negative status codes, the process is never
+ * terminated. minknap_error() describes the last error of a workspace.
+ */
+
+#ifndef MINKNAP_H
+#define MINKNAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* status codes */
+#define MINKNAP_OK              0
+#define MINKNAP_ERR_ARGS       -1   /* invalid arguments              */
+#define MINKNAP_ERR_NOMEM      -2   /* allocation failed              */
+#define MINKNAP_ERR_INTERNAL   -4   /* inconsistency inside algorithm */
+
+/* width of profits, weights and the capacity: 32 (default) or 64 bits.
+ * The library and all of its users must be built with the same value. */
+#ifndef MINKNAP_ITEM_BITS
+#define MINKNAP_ITEM_BITS 32
+#endif
+
+#if MINKNAP_ITEM_BITS == 32
+typedef int minknap_item;
+#elif MINKNAP_ITEM_BITS == 64
+typedef long long minknap_item;
+#else
+#error "MINKNAP_ITEM_BITS must be 32 or 64"
+#endif
+typedef long long minknap_sum;      /* sum of profits or weights      */
+
+typedef struct minknap_workspace minknap_workspace;
+
+minknap_workspace *minknap_create(void);
+void minknap_destroy(minknap_workspace *ws);
+
+/* solves the problem given by p[], w[] and c, the optimal solution
+ * vector is returned in x[] and its objective value in *z. When all the
+ * items fit, every x[j] is 1 and *z is the sum of the profits */
+int minknap_solve(minknap_workspace *ws, int n, minknap_item *p,
+                  minknap_item *w, int *x, minknap_item c, minknap_sum *z);
+
+/* as minknap_solve, but starts from the feasible solution x0[] of value
+ * z0, e.g. found by a heuristic, instead of the greedy solution. The
+ * closer z0 is to the optimum, the fewer states survive the bound tests,
+ * which saves time and memory on hard instances. MINKNAP_ERR_ARGS if x0[]
+ * doesn't fit or isn't worth z0; x0 and x may be the same array */
+int minknap_solve_warm(minknap_workspace *ws, int n, minknap_item *p,
+                       minknap_item *w, int *x, minknap_item c,
+                       const int *x0, minknap_sum z0, minknap_sum *z);
+
+/* break item of the LP relaxation, found with the same partial sort as
+ * minknap_solve in linear expected time. The items before the break in
+ * the order of profit/weight ratio fill the knapsack as far as they fit. */
+typedef struct {
+    int          b;         /* index of the break item, -1 if all fit */
+    minknap_item pb, wb;    /* its profit and weight, 0 if all fit    */
+    minknap_sum  psumb;     /* profit and weight of the items which   */
+    minknap_sum  wsumb;     /* are before the break                   */
+    minknap_sum  dantzig;   /* Dantzig upper bound                    */
+    minknap_sum  greedy;    /* profit of the greedy solution          */
+} minknap_bound;
+
+/* finds the break item and the bounds of the problem given by p[], w[]
+ * and c without solving it, the greedy solution is returned in x[] */
+int minknap_break(minknap_workspace *ws, int n, minknap_item *p,
+                  minknap_item *w, int *x, minknap_item c,
+                  minknap_bound *bound);
+
+const char *minknap_error(const minknap_workspace *ws);
+
+/* original interface, returns -1 if the problem could not be solved */
+minknap_sum minknap(int n, minknap_item *p, minknap_item *w, int *x,
+                    minknap_item c);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
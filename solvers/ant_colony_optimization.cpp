@@ -0,0 +1,424 @@
+#include "ant_colony_optimization.h"
+#include "pheromone_trail.h"
+#include "roulette.h"
+
+#include <cmath>
+#include <thread>
+#include <algorithm>
+#include <random>
+
+
+using ACO = AntColonyKnapsackOptimization;
+
+namespace
+{
+    class Knapsack
+    {
+    private:
+        int m_Cap;
+        const ACO::Items* m_items;
+        Bitset m_x;
+
+        // current cost
+        int m_C;
+        // cutrrent weight
+        int m_W;
+
+    public:
+        Knapsack(const ACO::Items& items, int Cap)
+            : m_Cap(Cap)
+            , m_items(&items)
+            , m_x(items.size())
+            , m_C(0)
+            , m_W(0)
+        {
+        }
+
+        int getCost() const { return m_C; }
+        int getWeight() const { return m_W; }
+        const Bitset& getSolution() const { return m_x; }
+        int getCap() const { return m_Cap; }
+
+        void evaluate()
+        {
+            long long W = 0;
+            long long C = 0;
+            m_items->evaluate(m_x, W, C);
+            m_W = int(W);
+            m_C = int(C);
+        }
+
+        bool canAddItem(int index) const
+        {
+            return !m_x.test(index) && 
+                m_W + m_items->w[index] <= m_Cap;
+        }
+
+        bool addItem(int index)
+        {
+            if (canAddItem(index))
+            {
+                m_x.set(index);
+                m_W += m_items->w[index];
+                m_C += m_items->c[index];
+                return true;
+            }
+            return false;
+        }
+    };
+
+    struct Edge
+    {
+        int i;
+        int j;
+
+        Edge(int i = -1, int j = -1)
+            : i(i)
+            , j(j)
+        {
+        }
+
+        bool isValid() const { return j >= 0; }
+    };
+    using Edges = std::vector<Edge>;
+
+    // every ant owns its generator, so ants can be built concurrently
+    using Rng = std::mt19937_64;
+
+    // uniform in [0, sum), 0 if sum isn't positive
+    double getRandom(Rng& rng, double sum)
+    {
+        if (!(sum > 0.0))
+            return 0.0;
+        std::uniform_real_distribution<double> distr(0.0, sum);
+
+        return distr(rng);
+    }
+
+    struct Ant
+    {
+        Knapsack knapsack;
+        Edges path;
+    };
+}
+
+struct ACO::Impl
+{
+    const double basePheromone = 0.001;
+    Logger logger;
+    StopCondition stop;
+
+    ACO::Items items;
+    // cost to weight ratio, the more attractiveness the better
+    std::vector<double> attractiveness;
+    // attractiveness ^ beta
+    std::vector<double> visibility;
+    // items sorted by weight, the heaviest first
+    std::vector<int> byWeight;
+    Bitset solution;
+    int Cap;
+    int Profit;
+
+    double alpha;
+    double beta;
+    double evaporation;
+
+    // ants built concurrently between two pheromone updates
+    int antsPerGeneration;
+    int numThreads;
+    unsigned long long seed;
+
+    PheromoneModel pheromoneModel;
+    std::unique_ptr<PheromoneTrail> pheromoneRemnant;
+
+    // edge pheromone depends on the current item, so the probabilities are
+    // recalculated on every step, but only over the items which still fit
+    Edge selectNextItem(int current, const Knapsack& knapsack, std::vector<int>& candidates,
+        std::vector<double>& factors, Rng& rng)
+    {
+        double sum = 0.0;
+        for (int k = 0; k < int(candidates.size()); )
+        {
+            const int i = candidates[k];
+
+            // the free capacity only decreases, so the item never fits again
+            if (!knapsack.canAddItem(i))
+            {
+                candidates[k] = candidates.back();
+                candidates.pop_back();
+                continue;
+            }
+
+            double pheromone = pheromoneRemnant->get(current, i);
+            factors[k] = pow(pheromone, alpha) * visibility[i];
+            sum += factors[k];
+            ++k;
+        }
+
+        if (candidates.empty())
+        {
+            // invalid edge
+            return Edge();
+        }
+
+        int selected = int(candidates.size()) - 1;
+        if (sum > 0.0)
+        {
+            const double r = getRandom(rng, sum);
+            double cp = 0.0;
+            for (int k = 0; k < int(candidates.size()); ++k)
+            {
+                cp += factors[k];
+                if (r < cp)
+                {
+                    selected = k;
+                    break;
+                }
+            }
+        }
+        else
+        {
+            // no pheromone left on any of the edges, every item is as good
+            selected = std::uniform_int_distribution<int>(0, selected)(rng);
+        }
+
+        Edge edge(current, candidates[selected]);
+        candidates[selected] = candidates.back();
+        candidates.pop_back();
+        return edge;
+    }
+
+    // with the pheromone on the items the probabilities don't depend on the current item,
+    // the roulette is built once per ant and items leave it as they stop fitting
+    std::pair<Knapsack, Edges> antActivityOnItems(Rng& rng)
+    {
+        Knapsack knapsack(items, Cap);
+
+        Edges path;
+
+        const int N = int(items.size());
+        std::vector<double> factors(N);
+        for (int i = 0; i < N; ++i)
+            factors[i] = pow(pheromoneRemnant->get(-1, i), alpha) * visibility[i];
+
+        Roulette roulette;
+        roulette.build(factors);
+
+        int current = -1;
+        int heaviest = 0;
+
+        while (knapsack.getWeight() < Cap)
+        {
+            const int free = Cap - knapsack.getWeight();
+            for (; heaviest < N && items.w[byWeight[heaviest]] > free; ++heaviest)
+                roulette.remove(byWeight[heaviest]);
+
+            if (roulette.empty())
+                break;
+
+            const int next = roulette.sample(getRandom(rng, roulette.total()));
+            if (next < 0)
+                break;
+
+            roulette.remove(next);
+            knapsack.addItem(next);
+            path.push_back(Edge(current, next));
+            current = next;
+        }
+
+        return { knapsack, path };
+    }
+
+    std::pair<Knapsack, Edges> antActivity(Rng& rng)
+    {
+        if (pheromoneModel == PheromoneModel::Item)
+            return antActivityOnItems(rng);
+
+        Knapsack knapsack(items, Cap);
+
+        Edges path;
+
+        const int N = int(items.size());
+        std::vector<int> candidates(N);
+        for (int i = 0; i < N; ++i)
+            candidates[i] = i;
+        std::vector<double> factors(N);
+
+        int current = -1;
+
+        while (knapsack.getWeight() < Cap)
+        {
+            auto next = selectNextItem( current, knapsack, candidates, factors, rng );
+            if (!next.isValid())
+                break;
+
+            knapsack.addItem(next.j);
+            path.push_back(next);
+            current = next.j;
+        }
+
+        return { knapsack, path };
+    }
+
+    // builds ants [first, first + count) of the colony, the pheromone is only read
+    std::vector<Ant> buildGeneration(int first, int count)
+    {
+        std::vector<Ant> ants(count, Ant{ Knapsack(items, Cap), Edges() });
+
+        auto worker = [&](int thread)
+        {
+            for (int k = thread; k < count; k += numThreads)
+            {
+                // the ant's random sequence depends only on its number in the colony
+                std::seed_seq seq{ seed, (unsigned long long)(first + k) };
+                Rng rng(seq);
+
+                auto [knapsack, path] = antActivity(rng);
+                ants[k].knapsack = std::move(knapsack);
+                ants[k].path = std::move(path);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (int t = 1; t < std::min(numThreads, count); ++t)
+            threads.emplace_back(worker, t);
+        worker(0);
+        for (auto& t : threads)
+            t.join();
+
+        return ants;
+    }
+
+    void run(int colonySize)
+    {
+        const int N = int(items.size());
+        switch (pheromoneModel)
+        {
+        case PheromoneModel::Dense: pheromoneRemnant = std::make_unique<DenseTrail>(N, basePheromone); break;
+        case PheromoneModel::Item: pheromoneRemnant = std::make_unique<ItemTrail>(N, basePheromone); break;
+        case PheromoneModel::Sparse: pheromoneRemnant = std::make_unique<SparseTrail>(N, basePheromone); break;
+        }
+
+        Knapsack best(items, Cap);
+
+        for (int first = 0; first < colonySize && !stop(); first += antsPerGeneration)
+        {
+            auto ants = buildGeneration(first, std::min(antsPerGeneration, colonySize - first));
+
+            for (int k = 0; k < int(ants.size()); ++k)
+            {
+                auto& ant = ants[k];
+                logger(first + k, ant.knapsack.getCost());
+
+                if (ant.knapsack.getCost() > best.getCost())
+                {
+                    best = ant.knapsack;
+                }
+            }
+
+            for (auto& ant : ants)
+            {
+                // pheromone amount which is left by the ant: 1 for the best
+                // cost, less the further the ant's cost is below it, and 1
+                // for every ant when nothing fits
+                double pheromone = 1.0;
+                if (best.getCost() > 0)
+                    pheromone = 1.0 / (1.0 + double(best.getCost() - ant.knapsack.getCost()) / best.getCost());
+
+                for (auto& edge : ant.path)
+                {
+                    pheromoneRemnant->deposit(edge.i, edge.j, pheromone);
+                }
+            }
+
+            // evaporate pheromone once per generation
+            pheromoneRemnant->evaporate(evaporation);
+        }
+
+        pheromoneRemnant.reset();
+
+        Profit = best.getCost();
+        solution = best.getSolution();
+    }
+
+    Impl(double alpha, double beta, double evaporation, PheromoneModel pheromoneModel)
+        : Cap(0)
+        , Profit(0)
+        , alpha(alpha)
+        , beta(beta)
+        , evaporation(evaporation)
+        , antsPerGeneration(1)
+        , numThreads(1)
+        , seed(std::random_device()())
+        , pheromoneModel(pheromoneModel)
+    {
+        logger = [](int, int) {};
+        stop = []() { return false; };
+    };
+};
+
+AntColonyKnapsackOptimization::AntColonyKnapsackOptimization(double alpha, double beta, double evaporation,
+    PheromoneModel pheromoneModel)
+    : m_impl(std::make_unique<Impl>(alpha, beta, evaporation, pheromoneModel))
+{
+}
+
+AntColonyKnapsackOptimization::~AntColonyKnapsackOptimization()
+{
+}
+
+void AntColonyKnapsackOptimization::setFxLogger(const Logger& logger)
+{
+    m_impl->logger = logger;
+}
+
+void AntColonyKnapsackOptimization::setStopCondition(const StopCondition& stop)
+{
+    m_impl->stop = stop;
+}
+
+void AntColonyKnapsackOptimization::setItems(const Items& items, int Cap)
+{
+    m_impl->items = items;
+    m_impl->Cap = Cap;
+    m_impl->Profit = 0;
+    m_impl->solution = Bitset(items.size());
+
+    m_impl->attractiveness.resize(items.size());
+    m_impl->visibility.resize(items.size());
+    m_impl->byWeight.resize(items.size());
+    for (int i = 0; i < int(items.size()); ++i)
+    {
+        m_impl->attractiveness[i] = double(items.c[i]) / double(items.w[i]);
+        m_impl->visibility[i] = pow(m_impl->attractiveness[i], m_impl->beta);
+        m_impl->byWeight[i] = i;
+    }
+    std::sort(m_impl->byWeight.begin(), m_impl->byWeight.end(),
+        [&](int a, int b) { return items.w[a] > items.w[b]; });
+}
+
+const Bitset& AntColonyKnapsackOptimization::getSolution() const
+{
+    return m_impl->solution;
+}
+
+int AntColonyKnapsackOptimization::getProfit() const
+{
+    return m_impl->Profit;
+}
+
+void AntColonyKnapsackOptimization::setColony(int antsPerGeneration, int numThreads)
+{
+    m_impl->antsPerGeneration = std::max(1, antsPerGeneration);
+    m_impl->numThreads = std::max(1, numThreads);
+}
+
+void AntColonyKnapsackOptimization::setSeed(unsigned long long seed)
+{
+    m_impl->seed = seed;
+}
+
+void AntColonyKnapsackOptimization::run(int colonySize)
+{
+    m_impl->run(colonySize);
+}
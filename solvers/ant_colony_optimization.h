@@ -0,0 +1,51 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <functional>
+
+#include "../common/knapsack_instance.h"
+
+class AntColonyKnapsackOptimization
+{
+public:
+    using Items = KnapsackInstance;
+    // called with every ant's number in the colony and the cost of its knapsack
+    using Logger = std::function<void(int ant, int cost)>;
+    // checked before every generation, the run ends when it returns true
+    using StopCondition = std::function<bool()>;
+
+    // where the ants leave their pheromone
+    enum class PheromoneModel
+    {
+        Dense,  // on every edge between two items, N x N matrix
+        Item,   // on the items themselves, O(N) memory and time
+        Sparse  // on the edges which were walked, the others share one value
+    };
+
+public:
+    AntColonyKnapsackOptimization(double alpha, double beta, double evaporation,
+        PheromoneModel pheromoneModel = PheromoneModel::Dense);
+    ~AntColonyKnapsackOptimization();
+    void setFxLogger(const Logger& logger);
+    void setStopCondition(const StopCondition& stop);
+    void setItems(const Items& items, int Cap);
+
+    // ants of one generation are built concurrently on numThreads threads,
+    // the pheromone is deposited and evaporated once per generation.
+    // The default of 1 ant per generation updates the pheromone after every ant
+    void setColony(int antsPerGeneration, int numThreads);
+    // every ant's random sequence is derived from the seed and the ant's number
+    void setSeed(unsigned long long seed);
+    
+    
+    const Bitset& getSolution() const;
+    int getProfit() const;
+
+    // colonySize is the total number of ants
+    void run(int colonySize);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
\ No newline at end of file
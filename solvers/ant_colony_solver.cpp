@@ -0,0 +1,60 @@
+#include "ant_colony_solver.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+AntColonySolver::AntColonySolver(PheromoneModel pheromoneModel, int antsPerGeneration, int colonySize)
+    : m_pheromoneModel(pheromoneModel)
+    , m_antsPerGeneration(std::max(1, antsPerGeneration))
+    , m_colonySize(std::max(1, colonySize))
+{
+}
+
+SolverResult AntColonySolver::solve(const KnapsackInstance& items, int Cap, const SolverOptions& options) const
+{
+    SolverBudget budget(options, m_colonySize);
+    SolverResult result;
+
+    AntColonyKnapsackOptimization alg(0.5, 2.5, 0.9, m_pheromoneModel);
+    alg.setColony(m_antsPerGeneration, options.numThreads);
+    alg.setItems(items, Cap);
+    // (seed, stream) is mixed into the colony's seed as the other solvers
+    // seed their generators, a plain sum would make pairs collide
+    std::seed_seq seq{ options.seed, options.stream };
+    unsigned int words[2];
+    seq.generate(words, words + 2);
+    alg.setSeed((unsigned long long)words[0] << 32 | words[1]);
+    alg.setStopCondition([&]() { return budget.timeIsUp() || budget.optimal(); });
+
+    // the logger is called on the thread which runs the colony
+    alg.setFxLogger([&](int ant, int cost)
+        {
+            const long long iteration = ant + 1;
+            result.stats.iterations = iteration;
+            // every ant builds and evaluates one solution
+            result.stats.evaluations = iteration;
+            if (options.onStep)
+                options.onStep({ iteration, cost, 0, iteration });
+            if (cost > result.profit)
+            {
+                result.profit = cost;
+                ++result.stats.improvements;
+                if (options.onImprove)
+                    options.onImprove({ iteration, cost, 0, iteration });
+                budget.reached(cost);
+            }
+        });
+
+    alg.run(int(std::min<long long>(budget.iterationLimit(), std::numeric_limits<int>::max())));
+
+    result.x = alg.getSolution();
+    result.profit = alg.getProfit();
+    long long W = 0;
+    long long C = 0;
+    items.evaluate(result.x, W, C);
+    result.weight = W;
+    result.stats.optimal = budget.optimal();
+    result.stats.seconds = budget.elapsed();
+    return result;
+}
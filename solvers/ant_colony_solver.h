@@ -0,0 +1,24 @@
+#pragma once
+
+#include "solver.h"
+#include "ant_colony_optimization.h"
+
+// AntColonyKnapsackOptimization behind the Solver interface,
+// options.iterationLimit is the number of ants and overrides colonySize
+class AntColonySolver : public Solver
+{
+public:
+    using PheromoneModel = AntColonyKnapsackOptimization::PheromoneModel;
+
+    explicit AntColonySolver(PheromoneModel pheromoneModel = PheromoneModel::Dense,
+        int antsPerGeneration = 1, int colonySize = 700);
+
+    const char* name() const override { return "aco"; }
+    // the ants of one generation are built on options.numThreads threads
+    SolverResult solve(const KnapsackInstance& items, int Cap, const SolverOptions& options) const override;
+
+private:
+    PheromoneModel m_pheromoneModel;
+    int m_antsPerGeneration;
+    int m_colonySize;
+};
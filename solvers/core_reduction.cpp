@@ -0,0 +1,215 @@
+#include "core_reduction.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <mutex>
+
+#include "../minknap/minknap.h"
+
+namespace
+{
+    // minknap_break() on the instance, x receives the greedy solution
+    int findBreak(const KnapsackInstance& items, int Cap, std::vector<int>& x, minknap_bound& bound)
+    {
+        // minknap takes non-const arrays of its own item width
+        std::vector<minknap_item> p(items.c.begin(), items.c.end());
+        std::vector<minknap_item> w(items.w.begin(), items.w.end());
+        minknap_workspace* ws = minknap_create();
+        const int status = ws != nullptr ?
+            minknap_break(ws, int(items.size()), p.data(), w.data(), x.data(), Cap, &bound) : MINKNAP_ERR_NOMEM;
+        minknap_destroy(ws);
+        return status;
+    }
+}
+
+Bitset CoreProblem::expand(const Bitset& x) const
+{
+    Bitset full = fixed;
+    for (size_t k = 0; k < index.size(); ++k)
+    {
+        if (x.test(k))
+            full.set(index[k]);
+    }
+    return full;
+}
+
+CoreProblem reduceToCore(const KnapsackInstance& items, int Cap, const SolverResult* incumbent)
+{
+    CoreProblem core;
+    const int n = int(items.size());
+    core.fixed = Bitset(n);
+    core.incumbent = Bitset(n);
+    if (n == 0)
+        return core;
+
+    std::vector<int> x(n, 0);
+    minknap_bound bound;
+    const int status = findBreak(items, Cap, x, bound);
+
+    if (status != MINKNAP_OK)
+    {
+        // nothing is fixed, the core is the whole instance
+        core.items = items;
+        core.Cap = Cap;
+        core.minWeight = *std::min_element(items.w.begin(), items.w.end());
+        core.index.resize(n);
+        for (int i = 0; i < n; ++i)
+            core.index[i] = i;
+        core.incumbentProfit = -1;
+        core.dantzig = std::numeric_limits<long long>::max();
+        return core;
+    }
+
+    for (int i = 0; i < n; ++i)
+    {
+        if (x[i])
+        {
+            core.incumbent.set(i);
+            core.incumbentWeight += items.w[i];
+        }
+    }
+    core.incumbentProfit = bound.greedy;
+    if (incumbent != nullptr && incumbent->x.size() == items.size() &&
+        incumbent->profit > core.incumbentProfit && incumbent->weight <= Cap)
+    {
+        core.incumbent = incumbent->x;
+        core.incumbentProfit = incumbent->profit;
+        core.incumbentWeight = incumbent->weight;
+    }
+    core.dantzig = bound.dantzig;
+    if (bound.b < 0)
+        return core;
+
+    // U - |d_j| <= z in units of w_b, where U * w_b is exact
+    const long long pb = bound.pb;
+    const long long wb = bound.wb;
+    const long long Uwb = bound.psumb * wb + (Cap - bound.wsumb) * pb;
+    const long long zwb = (core.incumbentProfit + 1) * wb;
+    for (int i = 0; i < n; ++i)
+    {
+        const long long dwb = items.c[i] * wb - items.w[i] * pb;
+        if (Uwb - std::llabs(dwb) < zwb && dwb != 0)
+        {
+            if (dwb > 0)
+            {
+                core.fixed.set(i);
+                core.fixedProfit += items.c[i];
+                core.fixedWeight += items.w[i];
+            }
+            continue;
+        }
+        core.index.push_back(i);
+    }
+
+    const int m = int(core.index.size());
+    core.items.resize(m);
+    core.minWeight = std::numeric_limits<int>::max();
+    for (int k = 0; k < m; ++k)
+    {
+        core.items.c[k] = items.c[core.index[k]];
+        core.items.w[k] = items.w[core.index[k]];
+        core.minWeight = std::min(core.minWeight, core.items.w[k]);
+    }
+    core.Cap = int(Cap - core.fixedWeight);
+    return core;
+}
+
+long long dantzigBound(const KnapsackInstance& items, int Cap)
+{
+    const int n = int(items.size());
+    if (n == 0)
+        return 0;
+
+    std::vector<int> x(n, 0);
+    minknap_bound bound;
+    const int status = findBreak(items, Cap, x, bound);
+    return status == MINKNAP_OK ? bound.dantzig : -1;
+}
+
+CoreSolver::CoreSolver(std::unique_ptr<Solver> solver)
+    : m_solver(std::move(solver))
+    , m_name(std::string(m_solver->name()) + "-core")
+{
+}
+
+SolverResult CoreSolver::solve(const KnapsackInstance& items, int Cap, const SolverOptions& options) const
+{
+    SolverBudget budget(options, 0);
+    const CoreProblem core = reduceToCore(items, Cap, options.incumbent);
+
+    SolverResult result;
+    result.x = core.incumbent;
+    result.profit = core.incumbentProfit;
+    result.weight = core.incumbentWeight;
+    result.stats.coreSize = (long long)core.items.size();
+    if (options.onImprove)
+        options.onImprove({ 0, result.profit, 0, 0 });
+
+    if (core.solved() || budget.reached(result.profit))
+    {
+        result.stats.optimal = true;
+        result.stats.seconds = budget.elapsed();
+        return result;
+    }
+
+    // the progress on the core is reported as profits of the whole instance
+    SolverOptions coreOptions = options;
+    const long long fixedProfit = core.fixedProfit;
+    if (options.onStep)
+    {
+        const SolverCallback onStep = options.onStep;
+        coreOptions.onStep = [onStep, fixedProfit](const SolverEvent& e)
+        {
+            SolverEvent shifted = e;
+            shifted.profit += fixedProfit;
+            onStep(shifted);
+        };
+    }
+    // only the improvements on what was reported, the incumbent first; the
+    // walkers of the inner solver may report concurrently, the lock keeps
+    // their reports in order
+    if (options.onImprove)
+    {
+        struct Reported
+        {
+            std::mutex mutex;
+            long long profit;
+        };
+        auto reported = std::make_shared<Reported>();
+        reported->profit = result.profit;
+        const SolverCallback onImprove = options.onImprove;
+        coreOptions.onImprove = [onImprove, fixedProfit, reported](const SolverEvent& e)
+        {
+            SolverEvent shifted = e;
+            shifted.profit += fixedProfit;
+            std::lock_guard<std::mutex> lock(reported->mutex);
+            if (shifted.profit <= reported->profit)
+                return;
+            reported->profit = shifted.profit;
+            onImprove(shifted);
+        };
+    }
+    // the incumbent is a solution of the whole instance, not of the core
+    coreOptions.incumbent = nullptr;
+    // the bound of the whole instance less the fixed items bounds the core
+    long long upperBound = core.dantzig;
+    if (options.upperBound >= 0)
+        upperBound = std::min(upperBound, options.upperBound);
+    coreOptions.upperBound = upperBound - core.fixedProfit;
+
+    const SolverResult coreResult = m_solver->solve(core.items, core.Cap, coreOptions);
+    result.stats.iterations = coreResult.stats.iterations;
+    result.stats.improvements = coreResult.stats.improvements;
+    result.stats.evaluations = coreResult.stats.evaluations;
+    if (coreResult.weight <= core.Cap && coreResult.profit + core.fixedProfit > result.profit)
+    {
+        result.x = core.expand(coreResult.x);
+        result.profit = coreResult.profit + core.fixedProfit;
+        result.weight = coreResult.weight + core.fixedWeight;
+    }
+    result.stats.optimal = coreResult.stats.optimal || budget.reached(result.profit);
+    result.stats.seconds = budget.elapsed();
+    return result;
+}
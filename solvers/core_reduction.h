@@ -0,0 +1,68 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "solver.h"
+
+// An instance reduced to its core. With the break item b of the LP
+// relaxation the reduced cost of item j is d_j = p_j - w_j * p_b / w_b,
+// and no solution with x_j flipped against the sign of d_j is worth more
+// than the Dantzig bound U - |d_j|. Where that is no better than the
+// incumbent, x_j is fixed: at 1 for d_j > 0 and at 0 for d_j < 0. Only
+// the free items, usually the ones around the break, are left to search.
+struct CoreProblem
+{
+    // the free items, and the index of each of them in the instance
+    KnapsackInstance items;
+    std::vector<int> index;
+    // capacity left by the items fixed at 1, negative if they don't fit
+    int Cap = 0;
+    // weight of the lightest free item
+    int minWeight = 0;
+    // the items fixed at 1
+    Bitset fixed;
+    long long fixedProfit = 0;
+    long long fixedWeight = 0;
+
+    // the best known solution of the whole instance, every solution of
+    // the core is better or the incumbent is optimal
+    Bitset incumbent;
+    long long incumbentProfit = 0;
+    long long incumbentWeight = 0;
+    long long dantzig = 0;
+
+    // the search over the core can't improve the incumbent: it holds no
+    // item which fits, which leaves the fixed items alone, a subset of the
+    // greedy solution, or the bound is reached
+    bool solved() const { return items.size() == 0 || Cap < minWeight || dantzig <= incumbentProfit; }
+
+    // the solution of the instance which a solution of the core stands for
+    Bitset expand(const Bitset& x) const;
+};
+
+// finds the break item with minknap's partial sort and fixes the items
+// which are the same in every solution better than the incumbent: the
+// greedy solution, or the given solution if it is better
+CoreProblem reduceToCore(const KnapsackInstance& items, int Cap, const SolverResult* incumbent = nullptr);
+
+// floor of the LP relaxation of the instance, from the same partial sort;
+// -1 if minknap can't take the instance
+long long dantzigBound(const KnapsackInstance& items, int Cap);
+
+// runs another solver on the core of the instance and maps its solution
+// and progress back to the whole instance
+class CoreSolver : public Solver
+{
+public:
+    explicit CoreSolver(std::unique_ptr<Solver> solver);
+
+    // the name of the solver with "-core" appended
+    const char* name() const override { return m_name.c_str(); }
+    SolverResult solve(const KnapsackInstance& items, int Cap, const SolverOptions& options) const override;
+
+private:
+    std::unique_ptr<Solver> m_solver;
+    std::string m_name;
+};
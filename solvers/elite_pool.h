@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <random>
+
+#include "../common/knapsack_instance.h"
+
+// Best states published by concurrently running tabu walkers.
+// Every walker owns one slot and is its only writer, publishing never
+// waits. Readers copy a slot under a sequence lock: they spin while the
+// owner is writing it and retry if it was rewritten meanwhile, so a fetch
+// waits for at most the publish in progress, never for a lock.
+class ElitePool
+{
+    struct Slot
+    {
+        // odd while the slot is being written
+        std::atomic<unsigned> sequence;
+        std::atomic<int> cost;
+        std::atomic<int> weight;
+        std::unique_ptr<std::atomic<Bitset::Word>[]> words;
+
+        explicit Slot(size_t numWords)
+            : sequence(0)
+            , cost(-1)
+            , weight(0)
+            , words(new std::atomic<Bitset::Word>[numWords])
+        {
+            for (size_t i = 0; i < numWords; ++i)
+                words[i].store(0, std::memory_order_relaxed);
+        }
+    };
+
+    size_t m_numItems;
+    size_t m_numWords;
+    std::vector<std::unique_ptr<Slot>> m_slots;
+
+    bool read(const Slot& slot, Bitset& x, int& cost, int& weight) const
+    {
+        x = Bitset(m_numItems);
+        for (;;)
+        {
+            const unsigned before = slot.sequence.load(std::memory_order_acquire);
+            if (before & 1)
+                continue;
+
+            cost = slot.cost.load(std::memory_order_relaxed);
+            weight = slot.weight.load(std::memory_order_relaxed);
+            Bitset::Word* words = x.data();
+            for (size_t i = 0; i < m_numWords; ++i)
+                words[i] = slot.words[i].load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) == before)
+                return cost >= 0;
+        }
+    }
+
+public:
+    ElitePool(int numSlots, size_t numItems)
+        : m_numItems(numItems)
+        , m_numWords(Bitset(numItems).numWords())
+    {
+        for (int i = 0; i < numSlots; ++i)
+            m_slots.emplace_back(new Slot(m_numWords));
+    }
+
+    int size() const { return int(m_slots.size()); }
+
+    // only the owner of the slot may publish into it
+    void publish(int slot, const Bitset& x, int cost, int weight)
+    {
+        Slot& s = *m_slots[slot];
+        const unsigned sequence = s.sequence.load(std::memory_order_relaxed);
+        s.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        s.cost.store(cost, std::memory_order_relaxed);
+        s.weight.store(weight, std::memory_order_relaxed);
+        const Bitset::Word* words = x.data();
+        for (size_t i = 0; i < m_numWords; ++i)
+            s.words[i].store(words[i], std::memory_order_relaxed);
+
+        s.sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    // copies a random published state, false if nothing is published yet
+    template <class Rng>
+    bool fetchRandom(Rng& rng, Bitset& x, int& cost, int& weight) const
+    {
+        std::vector<const Slot*> published;
+        for (auto& s : m_slots)
+        {
+            if (s->cost.load(std::memory_order_relaxed) >= 0)
+                published.push_back(s.get());
+        }
+        if (published.empty())
+            return false;
+
+        std::uniform_int_distribution<size_t> pick(0, published.size() - 1);
+        return read(*published[pick(rng)], x, cost, weight);
+    }
+};
@@ -0,0 +1,190 @@
+#include "flip_scan.h"
+
+#include <limits>
+
+#ifdef FLIP_SCAN_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define FLIP_SCAN_AVX2
+#else
+#define FLIP_SCAN_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace
+{
+    struct Candidate
+    {
+        double score;
+        int index;
+    };
+
+    inline int cost(const FlipScanInput& in, int i, bool selected)
+    {
+        const int Wy = selected ? in.W - in.w[i] : in.W + in.w[i];
+        if (Wy > in.Cap)
+            return 0;
+        return selected ? in.C - in.c[i] : in.C + in.c[i];
+    }
+
+    // scalar scan of [first, in.n), continues from the given best candidate
+    FlipScanResult scanRange(const FlipScanInput& in, int first, Candidate best)
+    {
+        for (int i = first; i < in.n; ++i)
+        {
+            const bool selected = (in.x[i / 64] >> (i % 64)) & 1;
+            const int Fy = cost(in, i, selected);
+
+            if (in.tabu[i] > in.now)
+            {
+                // aspiration
+                if (Fy > in.bestCost)
+                    return { i, true };
+            }
+            else
+            {
+                const double score = Fy - in.alpha * in.longMemory[i];
+                if (score > best.score)
+                    best = { score, i };
+            }
+        }
+        return { best.index, false };
+    }
+}
+
+FlipScanResult scanFlipsScalar(const FlipScanInput& in)
+{
+    return scanRange(in, 0, { 0.0, -1 });
+}
+
+#ifdef FLIP_SCAN_X86
+bool flipScanHasAvx2()
+{
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6)
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+FLIP_SCAN_AVX2 FlipScanResult scanFlipsAvx2(const FlipScanInput& in)
+{
+    const __m256i bitSelect = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    const __m256i C = _mm256_set1_epi32(in.C);
+    const __m256i W = _mm256_set1_epi32(in.W);
+    const __m256i Cap = _mm256_set1_epi32(in.Cap);
+    const __m256i now = _mm256_set1_epi32(in.now);
+    const __m256i bestCost = _mm256_set1_epi32(in.bestCost);
+    const __m256d alpha = _mm256_set1_pd(in.alpha);
+    const __m256d lane = _mm256_setr_pd(0.0, 1.0, 2.0, 3.0);
+
+    // per lane best score and its index, lanes 0-3 and 4-7 separately
+    __m256d bestLo = _mm256_setzero_pd();
+    __m256d bestHi = _mm256_setzero_pd();
+    __m256d indexLo = _mm256_set1_pd(-1.0);
+    __m256d indexHi = _mm256_set1_pd(-1.0);
+
+    const int n8 = in.n & ~7;
+    int i = 0;
+    for (; i < n8; i += 8)
+    {
+        const __m256i c = _mm256_loadu_si256((const __m256i*)(in.c + i));
+        const __m256i w = _mm256_loadu_si256((const __m256i*)(in.w + i));
+        const __m256i tabuUntil = _mm256_loadu_si256((const __m256i*)(in.tabu + i));
+        const __m256i flips = _mm256_loadu_si256((const __m256i*)(in.longMemory + i));
+
+        // expand 8 solution bits to lane masks
+        const int bits = int((in.x[i / 64] >> (i % 64)) & 0xFF);
+        const __m256i selected = _mm256_cmpeq_epi32(
+            _mm256_and_si256(_mm256_set1_epi32(bits), bitSelect), bitSelect);
+
+        // flipping a selected item removes it: (v ^ s) - s negates v where s = -1
+        const __m256i dc = _mm256_sub_epi32(_mm256_xor_si256(c, selected), selected);
+        const __m256i dw = _mm256_sub_epi32(_mm256_xor_si256(w, selected), selected);
+
+        const __m256i overflow = _mm256_cmpgt_epi32(_mm256_add_epi32(W, dw), Cap);
+        const __m256i Fy = _mm256_andnot_si256(overflow, _mm256_add_epi32(C, dc));
+
+        const __m256i tabu = _mm256_cmpgt_epi32(tabuUntil, now);
+        const __m256i aspiration = _mm256_and_si256(tabu, _mm256_cmpgt_epi32(Fy, bestCost));
+        const int aspirationMask = _mm256_movemask_ps(_mm256_castsi256_ps(aspiration));
+        if (aspirationMask != 0)
+        {
+            int first = 0;
+            while (!(aspirationMask & (1 << first)))
+                ++first;
+            return { i + first, true };
+        }
+
+        // penalized score, tabu lanes never win
+        const __m128i tabuLo = _mm256_castsi256_si128(tabu);
+        const __m128i tabuHi = _mm256_extracti128_si256(tabu, 1);
+        const __m256d scoreLo = _mm256_sub_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(Fy)),
+            _mm256_mul_pd(alpha, _mm256_cvtepi32_pd(_mm256_castsi256_si128(flips))));
+        const __m256d scoreHi = _mm256_sub_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(Fy, 1)),
+            _mm256_mul_pd(alpha, _mm256_cvtepi32_pd(_mm256_extracti128_si256(flips, 1))));
+
+        const __m256d betterLo = _mm256_andnot_pd(_mm256_castsi256_pd(_mm256_cvtepi32_epi64(tabuLo)),
+            _mm256_cmp_pd(scoreLo, bestLo, _CMP_GT_OQ));
+        const __m256d betterHi = _mm256_andnot_pd(_mm256_castsi256_pd(_mm256_cvtepi32_epi64(tabuHi)),
+            _mm256_cmp_pd(scoreHi, bestHi, _CMP_GT_OQ));
+
+        const __m256d base = _mm256_set1_pd(double(i));
+        bestLo = _mm256_blendv_pd(bestLo, scoreLo, betterLo);
+        bestHi = _mm256_blendv_pd(bestHi, scoreHi, betterHi);
+        indexLo = _mm256_blendv_pd(indexLo, _mm256_add_pd(base, lane), betterLo);
+        indexHi = _mm256_blendv_pd(indexHi, _mm256_add_pd(base, _mm256_add_pd(lane, _mm256_set1_pd(4.0))), betterHi);
+    }
+
+    // reduce the lanes, ties go to the lowest index like in the scalar scan
+    alignas(32) double scores[8];
+    alignas(32) double indices[8];
+    _mm256_store_pd(scores, bestLo);
+    _mm256_store_pd(scores + 4, bestHi);
+    _mm256_store_pd(indices, indexLo);
+    _mm256_store_pd(indices + 4, indexHi);
+
+    Candidate best = { 0.0, -1 };
+    for (int k = 0; k < 8; ++k)
+    {
+        if (indices[k] < 0.0)
+            continue;
+        const int index = int(indices[k]);
+        if (scores[k] > best.score || (scores[k] == best.score && index < best.index))
+            best = { scores[k], index };
+    }
+
+    return scanRange(in, i, best);
+}
+#endif
+
+namespace
+{
+    using ScanFunction = FlipScanResult(*)(const FlipScanInput&);
+
+    ScanFunction selectScan()
+    {
+#ifdef FLIP_SCAN_X86
+        if (flipScanHasAvx2())
+            return scanFlipsAvx2;
+#endif
+        return scanFlipsScalar;
+    }
+}
+
+FlipScanResult scanFlips(const FlipScanInput& in)
+{
+    static const ScanFunction scan = selectScan();
+    return scan(in);
+}
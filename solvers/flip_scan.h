@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+
+// everything the 1-flip neighbourhood scan needs to know about the current iteration
+struct FlipScanInput
+{
+    const int* c;              // item costs
+    const int* w;              // item weights
+    const uint64_t* x;         // current solution, packed 64 items per word
+    const int* tabu;           // item i is tabu while tabu[i] > now
+    const int* longMemory;     // number of times item i was flipped
+
+    int n;                     // number of items
+    int C;                     // current cost
+    int W;                     // current weight
+    int Cap;
+    int now;
+    int bestCost;              // aspiration level
+    double alpha;              // long memory penalty
+};
+
+struct FlipScanResult
+{
+    int index;                 // flipped item, -1 if there is no admissible move
+    bool aspiration;           // the move is tabu but beats the best known cost
+};
+
+// Evaluates all N one-flip neighbours in one pass and selects the move:
+// the first tabu neighbour which is better than bestCost, otherwise the
+// non tabu neighbour with the highest positive penalized cost
+//     Fy - alpha * longMemory[i]
+// where Fy is 0 for neighbours exceeding the capacity.
+// Uses AVX2 when the CPU supports it.
+FlipScanResult scanFlips(const FlipScanInput& in);
+
+// portable implementation, selected when AVX2 isn't available
+FlipScanResult scanFlipsScalar(const FlipScanInput& in);
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define FLIP_SCAN_X86 1
+
+// whether the CPU supports AVX2
+bool flipScanHasAvx2();
+
+// the same scan 8 items at a time, only to be called when flipScanHasAvx2()
+FlipScanResult scanFlipsAvx2(const FlipScanInput& in);
+#endif
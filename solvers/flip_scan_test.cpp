@@ -0,0 +1,98 @@
+// Compares the AVX2 kernel of scanFlips with the scalar scan on random
+// iterations: lengths which aren't a multiple of 8, tabu items, aspiration
+// and ties between the penalized costs.
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "flip_scan.h"
+
+int main(int argc, char* argv[])
+{
+#ifdef FLIP_SCAN_X86
+    if (!flipScanHasAvx2())
+    {
+        printf("AVX2 isn't supported, nothing to compare\n");
+        return 0;
+    }
+
+    const int trials = argc > 1 ? atoi(argv[1]) : 100000;
+    std::mt19937 rng(1);
+    int failures = 0;
+    int aspirations = 0;
+    int noMove = 0;
+
+    for (int trial = 0; trial < trials; ++trial)
+    {
+        const int n = std::uniform_int_distribution<int>(1, 200)(rng);
+        // small ranges make ties and infeasible flips common
+        const int maxValue = trial % 2 == 0 ? 10 : 1000;
+        std::uniform_int_distribution<int> value(1, maxValue);
+
+        std::vector<int> c(n), w(n), tabu(n), longMemory(n);
+        std::vector<uint64_t> x((n + 63) / 64, 0);
+        int C = 0;
+        int W = 0;
+        for (int i = 0; i < n; ++i)
+        {
+            c[i] = value(rng);
+            w[i] = value(rng);
+            if (rng() % 2)
+            {
+                x[i / 64] |= uint64_t(1) << (i % 64);
+                C += c[i];
+                W += w[i];
+            }
+        }
+
+        const int now = 100;
+        const int tabuPercent = std::uniform_int_distribution<int>(0, 100)(rng);
+        for (int i = 0; i < n; ++i)
+        {
+            tabu[i] = int(rng() % 100) < tabuPercent ? now + 1 + int(rng() % 10) : now - int(rng() % 10);
+            longMemory[i] = int(rng() % 20);
+        }
+
+        FlipScanInput in;
+        in.c = c.data();
+        in.w = w.data();
+        in.x = x.data();
+        in.tabu = tabu.data();
+        in.longMemory = longMemory.data();
+        in.n = n;
+        in.C = C;
+        in.W = W;
+        in.Cap = std::uniform_int_distribution<int>(W - maxValue, W + 2 * maxValue)(rng);
+        in.now = now;
+        // around the current cost, so that some tabu flips beat it
+        in.bestCost = C + std::uniform_int_distribution<int>(-maxValue, 2 * maxValue)(rng);
+        const double alphas[] = { 0.0, 0.5, 1.0, 3.25 };
+        in.alpha = alphas[rng() % 4];
+
+        const FlipScanResult scalar = scanFlipsScalar(in);
+        const FlipScanResult avx2 = scanFlipsAvx2(in);
+        if (scalar.index != avx2.index || scalar.aspiration != avx2.aspiration)
+        {
+            if (failures++ < 10)
+            {
+                printf("trial %d, n %d: scalar %d%s, avx2 %d%s\n", trial, n,
+                    scalar.index, scalar.aspiration ? " (aspiration)" : "",
+                    avx2.index, avx2.aspiration ? " (aspiration)" : "");
+            }
+        }
+        aspirations += scalar.aspiration;
+        noMove += scalar.index < 0;
+    }
+
+    printf("%d trials, %d aspiration moves, %d without a move, %d mismatches\n",
+        trials, aspirations, noMove, failures);
+    return failures == 0 ? 0 : 1;
+#else
+    (void)argc;
+    (void)argv;
+    printf("no AVX2 kernel on this architecture\n");
+    return 0;
+#endif
+}
@@ -0,0 +1,40 @@
+#include "greedy_repair.h"
+
+#include <algorithm>
+#include <limits>
+
+GreedyRepair::GreedyRepair(const KnapsackInstance& items, const Bitset& x)
+    : m_items(&items)
+    , m_order(items.size())
+    , m_rank(items.size())
+    , m_minWeightFrom(items.size() + 1)
+{
+    const int n = int(items.size());
+    for (int i = 0; i < n; ++i)
+        m_order[i] = i;
+    // c[a] / w[a] > c[b] / w[b] without rounding
+    std::sort(m_order.begin(), m_order.end(), [&](int a, int b)
+        {
+            return (long long)items.c[a] * items.w[b] > (long long)items.c[b] * items.w[a];
+        });
+
+    m_minWeightFrom[n] = std::numeric_limits<int>::max();
+    for (int k = n - 1; k >= 0; --k)
+    {
+        m_rank[m_order[k]] = k;
+        m_minWeightFrom[k] = std::min(m_minWeightFrom[k + 1], items.w[m_order[k]]);
+    }
+
+    reset(x);
+}
+
+void GreedyRepair::reset(const Bitset& x)
+{
+    const int n = int(m_order.size());
+    m_ranked = Bitset(n);
+    for (int k = 0; k < n; ++k)
+    {
+        if (x.test(m_order[k]))
+            m_ranked.set(k);
+    }
+}
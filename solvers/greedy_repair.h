@@ -0,0 +1,85 @@
+#pragma once
+
+#include <vector>
+
+#include "../common/knapsack_instance.h"
+
+// Greedy repair and fill of a solution in the order of profit / weight
+// ratio. The items are sorted by ratio once; the repair keeps its own copy
+// of the solution with the bits in that order, so both of its passes skip
+// 64 items at a time over the ones which can't change.
+// The caller owns the solution and reports every flip it makes itself.
+class GreedyRepair
+{
+public:
+    GreedyRepair(const KnapsackInstance& items, const Bitset& x);
+
+    // the solution was replaced
+    void reset(const Bitset& x);
+    // item i of the solution was flipped
+    void flip(int i) { m_ranked.flip(m_rank[i]); }
+
+    // Drops the selected items of the worst ratio until W <= Cap, then adds
+    // the unselected items of the best ratio which fit and for which
+    // allowed(i) holds. changed(i) is called for every item flipped, the
+    // caller applies the flip to its solution; W and C are updated.
+    template <class Allowed, class Changed>
+    void repair(long long& W, long long& C, int Cap, Allowed allowed, Changed changed);
+
+private:
+    const KnapsackInstance* m_items;
+    // items by decreasing ratio
+    std::vector<int> m_order;
+    // position of every item in m_order
+    std::vector<int> m_rank;
+    // lightest weight at positions k and above, ends the fill early
+    std::vector<int> m_minWeightFrom;
+    // bit k is set if the item at position k is selected
+    Bitset m_ranked;
+};
+
+template <class Allowed, class Changed>
+void GreedyRepair::repair(long long& W, long long& C, int Cap, Allowed allowed, Changed changed)
+{
+    const KnapsackInstance& items = *m_items;
+    const int n = int(m_order.size());
+    Bitset::Word* words = m_ranked.data();
+    const int numWords = int(m_ranked.numWords());
+
+    // drop, the worst ratio first
+    for (int k = numWords - 1; k >= 0 && W > Cap; --k)
+    {
+        for (Bitset::Word word = words[k]; word != 0 && W > Cap; )
+        {
+            const int bit = Bitset::highestBit(word);
+            word &= ~(Bitset::Word(1) << bit);
+
+            const int i = m_order[k * Bitset::WordBits + bit];
+            words[k] &= ~(Bitset::Word(1) << bit);
+            W -= items.w[i];
+            C -= items.c[i];
+            changed(i);
+        }
+    }
+
+    // fill, the best ratio first
+    for (int k = 0; k < numWords; ++k)
+    {
+        const int first = k * Bitset::WordBits;
+        if (Cap - W < m_minWeightFrom[first])
+            break;
+        for (Bitset::Word word = ~words[k]; word != 0; word &= word - 1)
+        {
+            const int bit = Bitset::lowestBit(word);
+            if (first + bit >= n)
+                break;
+            const int i = m_order[first + bit];
+            if (W + items.w[i] > Cap || !allowed(i))
+                continue;
+            words[k] |= Bitset::Word(1) << bit;
+            W += items.w[i];
+            C += items.c[i];
+            changed(i);
+        }
+    }
+}
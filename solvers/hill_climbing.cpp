@@ -0,0 +1,496 @@
+#include "hill_climbing.h"
+#include "greedy_repair.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // solution variables, the items themselves are shared by all passes
+    using State = Bitset;
+    // every pass owns its generator, so passes can run concurrently
+    // and each one is reproducible from (seed, stream) alone
+    using Rng = std::mt19937_64;
+
+    // set of flipped indices which is reused between attempts
+    // membership is checked with generation stamps, so clear() doesn't touch the arrays
+    class FlipBuffer
+    {
+        std::vector<int> m_indices;
+        std::vector<unsigned> m_stamps;
+        unsigned m_generation;
+        int m_size;
+
+    public:
+        explicit FlipBuffer(int numItems)
+            : m_indices(numItems)
+            , m_stamps(numItems, 0)
+            , m_generation(1)
+            , m_size(0)
+        {
+        }
+
+        void clear()
+        {
+            m_size = 0;
+            if (++m_generation == 0)
+            {
+                // stamps wrapped around, forget all of them
+                std::fill(m_stamps.begin(), m_stamps.end(), 0);
+                m_generation = 1;
+            }
+        }
+
+        bool insert(int i)
+        {
+            if (m_stamps[i] == m_generation)
+                return false;
+            m_stamps[i] = m_generation;
+            m_indices[m_size++] = i;
+            return true;
+        }
+
+        int size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+        const int* begin() const { return m_indices.data(); }
+        const int* end() const { return m_indices.data() + m_size; }
+    };
+
+    void initRandomState(const KnapsackInstance& items, State& state, int Cap, Rng& rng)
+    {
+        std::uniform_int_distribution<int> pick(0, int(state.size()) - 1);
+        int W = 0;
+        for (int i = 0; i < int(state.size()); ++i )
+        {
+            int j = pick(rng);
+            if (W + items.w[j] <= Cap)
+            {
+                state.set(j);
+                W += items.w[j];
+            }
+        }
+    }
+
+    void findNeighbour(const State& x, int distance, FlipBuffer& flipped, Rng& rng )
+    {
+        flipped.clear();
+        int rdistance = std::uniform_int_distribution<int>(1, distance)(rng);
+        std::uniform_int_distribution<int> pick(0, int(x.size()) - 1);
+        for (int i = 0; i < rdistance; ++i)
+        {
+            // avoid double flips
+            flipped.insert(pick(rng));
+        }
+    }
+
+    int evaluateFull(const KnapsackInstance& items, const State& x, int& W0, int& C0, int Cap)
+    {
+        long long W = 0;
+        long long C = 0;
+        items.evaluate(x, W, C);
+        W0 = int(W);
+        C0 = int(C);
+
+        return W0 > Cap ? 0 : C0;
+    }
+
+    int evaluateDelta(const KnapsackInstance& items, const State& x, int W0, int C0, int Cap, const FlipBuffer& modified, int& Wy, int& Cy)
+    {
+        Wy = W0;
+        Cy = C0;
+        for (auto& i : modified)
+        {
+            bool flip = !x.test(i);
+            if (flip)
+            {
+                Wy += items.w[i];
+                Cy += items.c[i];
+            }
+            else
+            {
+                Wy -= items.w[i];
+                Cy -= items.c[i];
+            }
+        }
+
+        return Wy > Cap ? 0 : Cy;
+    }
+
+    void updateDelta(State& x, const FlipBuffer& modified)
+    {
+        for (auto& i : modified)
+        {
+            x.flip(i);
+        }
+
+    }
+
+    // applies the neighbour to x, then repairs and fills it; the flips made
+    // by the repair are kept in repaired, so that the move can be undone
+    int evaluateRepaired(const KnapsackInstance& items, State& x, GreedyRepair& repair, int W0, int C0, int Cap,
+        const FlipBuffer& modified, std::vector<int>& repaired, int& Wy, int& Cy)
+    {
+        long long W = W0;
+        long long C = C0;
+        for (auto& i : modified)
+        {
+            const int sign = x.test(i) ? -1 : 1;
+            W += sign * items.w[i];
+            C += sign * items.c[i];
+            x.flip(i);
+            repair.flip(i);
+        }
+
+        repaired.clear();
+        repair.repair(W, C, Cap, [](int) { return true; }, [&](int i)
+            {
+                x.flip(i);
+                repaired.push_back(i);
+            });
+        Wy = int(W);
+        Cy = int(C);
+        return Cy;
+    }
+
+    void undoRepaired(State& x, GreedyRepair& repair, const FlipBuffer& modified, const std::vector<int>& repaired)
+    {
+        for (auto& i : modified)
+        {
+            x.flip(i);
+            repair.flip(i);
+        }
+        for (int i : repaired)
+        {
+            x.flip(i);
+            repair.flip(i);
+        }
+    }
+
+    // unselected items in order of weight; a max tree over the order gives
+    // the most profitable of the lightest k of them in O(log N), so the best
+    // item which fits into a residual capacity is one binary search and one
+    // query away
+    class WeightIndex
+    {
+        const KnapsackInstance* m_items;
+        // items by increasing weight, and their weights
+        std::vector<int> m_order;
+        std::vector<int> m_weights;
+        // position of every item in m_order
+        std::vector<int> m_rank;
+        // best position in every subtree, -1 if all of them are selected
+        std::vector<int> m_tree;
+        int m_leaves;
+
+        int better(int a, int b) const
+        {
+            if (a < 0)
+                return b;
+            if (b < 0)
+                return a;
+            return m_items->c[m_order[a]] >= m_items->c[m_order[b]] ? a : b;
+        }
+
+        void assign(int position, int value)
+        {
+            int node = m_leaves + position;
+            m_tree[node] = value;
+            for (node /= 2; node >= 1; node /= 2)
+                m_tree[node] = better(m_tree[2 * node], m_tree[2 * node + 1]);
+        }
+
+    public:
+        WeightIndex(const KnapsackInstance& items, const State& x)
+            : m_items(&items)
+            , m_order(items.size())
+            , m_weights(items.size())
+            , m_rank(items.size())
+            , m_leaves(1)
+        {
+            const int n = int(items.size());
+            for (int i = 0; i < n; ++i)
+                m_order[i] = i;
+            std::sort(m_order.begin(), m_order.end(), [&](int a, int b) { return items.w[a] < items.w[b]; });
+            for (int k = 0; k < n; ++k)
+            {
+                m_rank[m_order[k]] = k;
+                m_weights[k] = items.w[m_order[k]];
+            }
+
+            while (m_leaves < n)
+                m_leaves *= 2;
+            m_tree.assign(2 * m_leaves, -1);
+            for (int k = 0; k < n; ++k)
+                m_tree[m_leaves + k] = x.test(m_order[k]) ? -1 : k;
+            for (int node = m_leaves - 1; node >= 1; --node)
+                m_tree[node] = better(m_tree[2 * node], m_tree[2 * node + 1]);
+        }
+
+        void select(int i) { assign(m_rank[i], -1); }
+        void deselect(int i) { assign(m_rank[i], m_rank[i]); }
+
+        // the most profitable unselected item of weight at most capacity, -1 if none fits
+        int best(long long capacity) const
+        {
+            const int k = int(std::upper_bound(m_weights.begin(), m_weights.end(), capacity) - m_weights.begin());
+            int found = -1;
+            for (int lo = m_leaves, hi = m_leaves + k; lo < hi; lo /= 2, hi /= 2)
+            {
+                if (lo & 1)
+                    found = better(found, m_tree[lo++]);
+                if (hi & 1)
+                    found = better(found, m_tree[--hi]);
+            }
+            return found < 0 ? -1 : m_order[found];
+        }
+    };
+
+    // drops up to one selected item and adds up to two unselected ones
+    struct Move
+    {
+        int drop = -1;
+        int add = -1;
+        int addSecond = -1;
+        long long gain = 0;
+    };
+
+    template <class F>
+    void forEachSelected(const State& x, F f)
+    {
+        const Bitset::Word* words = x.data();
+        for (size_t k = 0; k < x.numWords(); ++k)
+        {
+            for (Bitset::Word word = words[k]; word != 0; word &= word - 1)
+                f(int(k * Bitset::WordBits) + Bitset::lowestBit(word));
+        }
+    }
+
+    // the best move of neighbourhood k for the residual capacity:
+    //   0  add one item
+    //   1  swap a selected item for an unselected one
+    //   2  greedy pair exchange: a selected item for the most profitable
+    //      unselected item which fits in its place, and then the most
+    //      profitable one which fits in the rest; for every dropped item
+    //      only this pair is tried, not every pair, which would cost a
+    //      scan of the unselected items per dropped item
+    Move bestMove(int k, const KnapsackInstance& items, const State& x, WeightIndex& index,
+        long long residual, long long& evaluations)
+    {
+        Move best;
+        if (k == 0)
+        {
+            ++evaluations;
+            const int j = index.best(residual);
+            if (j >= 0)
+            {
+                best.add = j;
+                best.gain = items.c[j];
+            }
+            return best;
+        }
+
+        forEachSelected(x, [&](int i)
+            {
+                const long long free = residual + items.w[i];
+                ++evaluations;
+                const int j = index.best(free);
+                if (j < 0)
+                    return;
+                int second = -1;
+                if (k == 2)
+                {
+                    index.select(j);
+                    ++evaluations;
+                    second = index.best(free - items.w[j]);
+                    index.deselect(j);
+                    if (second < 0)
+                        return;
+                }
+                const long long gain = items.c[j] + (second >= 0 ? items.c[second] : 0) - items.c[i];
+                if (gain > best.gain)
+                {
+                    best.drop = i;
+                    best.add = j;
+                    best.addSecond = second;
+                    best.gain = gain;
+                }
+            });
+        return best;
+    }
+
+    // variable neighbourhood descent: the best improving move of the first
+    // neighbourhood which has one is made, and the search goes back to the
+    // first neighbourhood; the climb ends in a local optimum of the add and
+    // swap moves where no greedy pair exchange improves either
+    void descend(const KnapsackInstance& items, int Cap, const SolverOptions& options, const SolverBudget& budget,
+        State& x, int& W0, int& C0, SolverResult& result)
+    {
+        const int NumNeighbourhoods = 3;
+        WeightIndex index(items, x);
+        long long numIterations = 0;
+        long long evaluations = 0;
+
+        for (int k = 0; k < NumNeighbourhoods && !budget.exhausted(numIterations) && !budget.timeIsUp(); )
+        {
+            ++numIterations;
+            const Move move = bestMove(k, items, x, index, (long long)Cap - W0, evaluations);
+            if (move.gain <= 0)
+            {
+                ++k;
+                continue;
+            }
+
+            if (move.drop >= 0)
+            {
+                x.reset(move.drop);
+                index.deselect(move.drop);
+                W0 -= items.w[move.drop];
+                C0 -= items.c[move.drop];
+            }
+            for (int j : { move.add, move.addSecond })
+            {
+                if (j < 0)
+                    continue;
+                x.set(j);
+                index.select(j);
+                W0 += items.w[j];
+                C0 += items.c[j];
+            }
+
+            ++result.stats.improvements;
+            if (options.onStep)
+                options.onStep({ numIterations, C0, 0, evaluations });
+            if (options.onImprove)
+                options.onImprove({ numIterations, C0, 0, evaluations });
+            budget.reached(C0);
+            k = 0;
+        }
+
+        result.stats.iterations = numIterations;
+        result.stats.evaluations = evaluations;
+    }
+}
+
+HillClimbingSolver::HillClimbingSolver(int numAttempts, Neighbourhoods neighbourhoods, bool repair)
+    : m_numAttempts(std::max(1, numAttempts))
+    , m_neighbourhoods(neighbourhoods)
+    , m_repair(repair)
+{
+}
+
+const char* HillClimbingSolver::name() const
+{
+    if (m_neighbourhoods == Neighbourhoods::Descent)
+        return "hc-vnd";
+    return m_repair ? "hc-repair" : "hc";
+}
+
+SolverResult HillClimbingSolver::solve(const KnapsackInstance& items, int Cap, const SolverOptions& options) const
+{
+    SolverBudget budget(options, 0);
+    std::seed_seq seq{ options.seed, options.stream };
+    Rng rng(seq);
+
+    SolverResult result;
+    State& x = result.x;
+    x = State(items.size());
+
+    initRandomState(items, x, Cap, rng);
+    int W0 = 0; 
+    int C0 = 0;
+    int Px = evaluateFull(items, x, W0, C0, Cap);
+
+    std::unique_ptr<GreedyRepair> repair;
+    std::vector<int> repaired;
+    if (m_repair && m_neighbourhoods == Neighbourhoods::RandomFlips)
+    {
+        repair = std::make_unique<GreedyRepair>(items, x);
+        long long W = W0;
+        long long C = C0;
+        repair->repair(W, C, Cap, [](int) { return true; }, [&](int i) { x.flip(i); });
+        W0 = int(W);
+        C0 = int(C);
+        Px = C0;
+    }
+
+    if (options.onImprove)
+        options.onImprove({ 0, Px, 0, 0 });
+    budget.reached(Px);
+
+    if (m_neighbourhoods == Neighbourhoods::Descent)
+    {
+        descend(items, Cap, options, budget, x, W0, C0, result);
+        result.profit = C0;
+        result.weight = W0;
+        result.stats.optimal = budget.optimal();
+        result.stats.seconds = budget.elapsed();
+        return result;
+    }
+
+    bool found = true;
+    int ndistance = x.size() / 2;
+
+    long long numIterations = 0;
+
+    FlipBuffer flipped(int(x.size()));
+
+    while (ndistance >= 1 && !budget.exhausted(numIterations))
+    {
+        found = false;
+        for (int i = 0; i < m_numAttempts; ++i)
+        {
+            ++numIterations;
+            findNeighbour(x, ndistance, flipped, rng);
+
+            int Wy = 0;
+            int Cy = 0;
+
+            int Py = repair ?
+                evaluateRepaired(items, x, *repair, W0, C0, Cap, flipped, repaired, Wy, Cy) :
+                evaluateDelta(items, x, W0, C0, Cap, flipped, Wy, Cy );
+            
+            if( Py > Px )
+            {
+                // the repaired neighbour is already applied
+                if (!repair)
+                    updateDelta(x, flipped);
+                W0 = Wy;
+                C0 = Cy;
+                Px = Py;
+                ++result.stats.improvements;
+                if (options.onStep)
+                    options.onStep({ numIterations, Py, 0, numIterations });
+                if (options.onImprove)
+                    options.onImprove({ numIterations, Py, 0, numIterations });
+                budget.reached(Py);
+
+                found = true;
+                ndistance = ndistance * 2;
+                if( ndistance > int(x.size()) )
+                    ndistance = int(x.size());
+
+                break;
+            }
+            if (repair)
+                undoRepaired(x, *repair, flipped, repaired);
+
+            if (budget.exhausted(numIterations))
+                break;
+        }
+        if (!found)
+        {
+            ndistance = ndistance / 2;
+        }
+    }
+
+    result.profit = Px;
+    result.weight = W0;
+    result.stats.iterations = numIterations;
+    // every attempt evaluates one neighbour
+    result.stats.evaluations = numIterations;
+    result.stats.optimal = budget.optimal();
+    result.stats.seconds = budget.elapsed();
+    return result;
+}
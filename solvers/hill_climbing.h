@@ -0,0 +1,33 @@
+#pragma once
+
+#include "solver.h"
+
+// random restarts of a variable distance hill climber: up to numAttempts
+// random neighbours are tried at the current distance, which doubles after
+// an improvement and halves otherwise; the climb ends below distance 1.
+// The descent climbs with the best add and 1-1 swap moves and a greedy
+// 1-2 exchange instead, which are found through an index of the items by
+// weight.
+// With repair the random neighbours are made feasible and filled up by the
+// greedy ratio repair of greedy_repair.h instead of being rejected
+class HillClimbingSolver : public Solver
+{
+public:
+    enum class Neighbourhoods
+    {
+        RandomFlips,  // random multi-flips at a variable distance
+        Descent       // variable neighbourhood descent, numAttempts is unused
+    };
+
+    explicit HillClimbingSolver(int numAttempts = 10000, Neighbourhoods neighbourhoods = Neighbourhoods::RandomFlips,
+        bool repair = false);
+
+    const char* name() const override;
+    // one climb from a random feasible state, options.numThreads is ignored
+    SolverResult solve(const KnapsackInstance& items, int Cap, const SolverOptions& options) const override;
+
+private:
+    int m_numAttempts;
+    Neighbourhoods m_neighbourhoods;
+    bool m_repair;
+};
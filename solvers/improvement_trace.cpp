@@ -0,0 +1,121 @@
+#include "improvement_trace.h"
+
+namespace
+{
+    // how often the writer looks for new records
+    const auto FlushPeriod = std::chrono::milliseconds(20);
+}
+
+ImprovementTrace::ImprovementTrace(const std::string& filepath, long long upperBound, size_t capacity)
+    : m_out(fopen(filepath.c_str(), "w"))
+    , m_upperBound(upperBound)
+    , m_mask(0)
+    , m_head(0)
+    , m_tail(0)
+    , m_dropped(0)
+    , m_stop(false)
+{
+    size_t size = 1;
+    while (size < capacity)
+        size *= 2;
+    m_slots.reset(new Slot[size]);
+    m_mask = size - 1;
+    for (size_t i = 0; i < size; ++i)
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+
+    if (m_out != NULL)
+        fprintf(m_out, "pass\tworker\tnanoseconds\titeration\tprofit\tevaluations\tgap\n");
+
+    m_writer = std::thread(&ImprovementTrace::writer, this);
+}
+
+ImprovementTrace::~ImprovementTrace()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_one();
+    m_writer.join();
+    if (m_out != NULL)
+        fclose(m_out);
+}
+
+void ImprovementTrace::record(const TraceRecord& r)
+{
+    size_t position = m_head.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        Slot& slot = m_slots[position & m_mask];
+        const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence == position)
+        {
+            if (m_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                slot.record = r;
+                slot.sequence.store(position + 1, std::memory_order_release);
+                return;
+            }
+        }
+        else if (sequence < position)
+        {
+            // the slot still holds a record from the previous round
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        else
+        {
+            position = m_head.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+SolverCallback ImprovementTrace::callback(int pass)
+{
+    const Clock::time_point start = Clock::now();
+    return [this, pass, start](const SolverEvent& e)
+    {
+        const long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+        record({ ns, e.iteration, e.profit, e.evaluations, pass, e.worker });
+    };
+}
+
+size_t ImprovementTrace::drain()
+{
+    size_t count = 0;
+    for (;;)
+    {
+        Slot& slot = m_slots[m_tail & m_mask];
+        if (slot.sequence.load(std::memory_order_acquire) != m_tail + 1)
+            break;
+
+        const TraceRecord& r = slot.record;
+        if (m_out != NULL)
+        {
+            fprintf(m_out, "%d\t%d\t%lld\t%lld\t%lld\t%lld\t%lld\n",
+                r.pass, r.worker, r.nanoseconds, r.iteration, r.profit, r.evaluations,
+                m_upperBound >= 0 ? m_upperBound - r.profit : -1);
+        }
+        // the slot is free for the record one round later
+        slot.sequence.store(m_tail + m_mask + 1, std::memory_order_release);
+        ++m_tail;
+        ++count;
+    }
+    return count;
+}
+
+void ImprovementTrace::writer()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;)
+    {
+        const bool stop = m_stop;
+        lock.unlock();
+        if (drain() > 0 && m_out != NULL)
+            fflush(m_out);
+        lock.lock();
+        if (stop)
+            break;
+        m_wake.wait_for(lock, FlushPeriod, [this]() { return m_stop; });
+    }
+}
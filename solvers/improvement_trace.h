@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "solver.h"
+
+// one improvement of a solver's best solution
+struct TraceRecord
+{
+    // time since the start of the pass
+    long long nanoseconds;
+    long long iteration;
+    long long profit;
+    long long evaluations;
+    int pass;
+    int worker;
+};
+
+// Records improvements into a preallocated ring buffer which a background
+// thread writes to a file, after a header one tab separated line per record:
+//
+//   pass  worker  nanoseconds  iteration  profit  evaluations  gap
+//
+// where gap is the distance of the profit to the upper bound of the
+// instance, or -1 if there's none.
+// Recording takes no lock and does no I/O, so it doesn't disturb the timings
+// of the solver. Several threads may record at once; when the writer falls
+// behind and the buffer is full, records are dropped and counted instead
+// of blocking the solver.
+class ImprovementTrace
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // capacity is rounded up to a power of 2; if the file can't be
+    // created the records are discarded
+    explicit ImprovementTrace(const std::string& filepath, long long upperBound = -1, size_t capacity = 1 << 16);
+    // writes the remaining records and closes the file
+    ~ImprovementTrace();
+
+    ImprovementTrace(const ImprovementTrace&) = delete;
+    ImprovementTrace& operator=(const ImprovementTrace&) = delete;
+
+    void record(const TraceRecord& r);
+
+    // an onImprove callback for one pass, its time starts now
+    SolverCallback callback(int pass);
+
+    long long dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot
+    {
+        // equals the position of the record which may be written into
+        // the slot, or that position + 1 once it is written
+        std::atomic<size_t> sequence;
+        TraceRecord record;
+    };
+
+    void writer();
+    // writes the records which are ready, returns their number
+    size_t drain();
+
+    FILE* m_out;
+    long long m_upperBound;
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_mask;
+    std::atomic<size_t> m_head;
+    size_t m_tail;
+    std::atomic<long long> m_dropped;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_stop;
+    std::thread m_writer;
+};
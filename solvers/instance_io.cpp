@@ -0,0 +1,75 @@
+#include "instance_io.h"
+
+#include <cstdarg>
+#include <mutex>
+
+#include "../common/knapsack_binary.h"
+#include "../common/knapsack_text.h"
+
+namespace
+{
+    std::mutex logMutex;
+
+    void vlog(FILE* f, bool echo, const char* format, va_list args)
+    {
+        char buffer[1024];
+        vsnprintf(buffer, sizeof(buffer), format, args);
+
+        std::lock_guard<std::mutex> lock(logMutex);
+        if (echo)
+            printf("%s", buffer);
+        if (f != NULL)
+        {
+            fprintf(f, "%s", buffer);
+            fflush(f);
+        }
+    }
+}
+
+KnapsackInstance loadItems(const std::string& filepath, int& Cap, int& Profit)
+{
+    KnapsackInstance items;
+    const bool loaded = knap_is_binary_path(filepath.c_str()) ?
+        loadBinaryItems(filepath, items, Cap, Profit) :
+        loadTextItems(filepath, items, Cap, Profit);
+    if (!loaded)
+        items.resize(0);
+    return items;
+}
+
+void saveItems(const std::string& filepath, const KnapsackInstance& items, const Bitset& x, int cap, int cost)
+{
+    FILE* out = fopen(filepath.c_str(), "w");
+    if (out != NULL)
+    {
+        fprintf(out, "%5llu     C     W\n", (unsigned long long)items.size());
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            fprintf(out, "%5d %5d %5d %5d\n", int(i), items.c[i], items.w[i], int(x.test(i)));
+        }
+        fprintf(out, "%d\n", cap);
+        fprintf(out, "%d\n", cost);
+        fclose(out);
+    }
+}
+
+void log(FILE* f, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    vlog(f, true, format, args);
+    va_end(args);
+}
+
+void logQuiet(FILE* f, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    vlog(f, false, format, args);
+    va_end(args);
+}
+
+std::string gapText(long long upperBound, long long profit)
+{
+    return upperBound >= 0 ? std::to_string(upperBound - profit) : "unknown";
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+
+#include "../common/knapsack_instance.h"
+
+// reads the test.in or test.out text layout, or a binary .kbin file;
+// the items are empty if the file is missing or malformed
+KnapsackInstance loadItems(const std::string& filepath, int& Cap, int& Profit);
+
+// writes the test.out layout
+void saveItems(const std::string& filepath, const KnapsackInstance& items, const Bitset& x, int cap, int cost);
+
+// appends to f and echoes to stdout, safe to call from several threads
+void log(FILE* f, const char* format, ...);
+// appends to f only
+void logQuiet(FILE* f, const char* format, ...);
+
+// the upper bound less the profit for the logs, "unknown" if the bound is
+// negative, which stands for no bound
+std::string gapText(long long upperBound, long long profit);
@@ -0,0 +1,88 @@
+#include "minknap_solver.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "../minknap/minknap.h"
+
+MinknapSolver::MinknapSolver(std::unique_ptr<Solver> warmStart, long long warmIterations)
+    : m_warmStart(std::move(warmStart))
+    , m_warmIterations(warmIterations)
+{
+}
+
+SolverResult MinknapSolver::solve(const KnapsackInstance& items, int Cap, const SolverOptions& options) const
+{
+    SolverBudget budget(options, 0);
+    SolverResult result;
+    result.x = Bitset(items.size());
+
+    const SolverResult* incumbent = options.incumbent;
+    SolverResult warm;
+    if (m_warmStart)
+    {
+        SolverOptions warmOptions = options;
+        if (warmOptions.iterationLimit <= 0)
+            warmOptions.iterationLimit = m_warmIterations;
+        warmOptions.onStep = nullptr;
+        warm = m_warmStart->solve(items, Cap, warmOptions);
+        // it reached the upper bound, minknap can't do better
+        if (warm.stats.optimal)
+        {
+            warm.stats.seconds = budget.elapsed();
+            return warm;
+        }
+        if (incumbent == nullptr || warm.profit > incumbent->profit)
+            incumbent = &warm;
+    }
+
+    // minknap takes non-const arrays of its own item width
+    const int n = int(items.size());
+    std::vector<minknap_item> p(items.c.begin(), items.c.end());
+    std::vector<minknap_item> w(items.w.begin(), items.w.end());
+    std::vector<int> x(n, 0);
+
+    // minknap checks the incumbent, a wrong one is left out
+    long long W0 = 0;
+    long long C0 = 0;
+    if (incumbent != nullptr && incumbent->x.size() == items.size())
+    {
+        items.evaluate(incumbent->x, W0, C0);
+        for (int i = 0; i < n; ++i)
+            x[i] = incumbent->x.test(i);
+    }
+
+    minknap_workspace* ws = minknap_create();
+    minknap_sum z = 0;
+    int status = MINKNAP_ERR_NOMEM;
+    if (ws != nullptr && C0 > 0 && W0 <= Cap)
+        status = minknap_solve_warm(ws, n, p.data(), w.data(), x.data(), Cap, x.data(), C0, &z);
+    if (ws != nullptr && status != MINKNAP_OK)
+    {
+        std::fill(x.begin(), x.end(), 0);
+        status = minknap_solve(ws, n, p.data(), w.data(), x.data(), Cap, &z);
+    }
+    minknap_destroy(ws);
+
+    if (status == MINKNAP_OK)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            if (x[i])
+                result.x.set(i);
+        }
+        long long W = 0;
+        long long C = 0;
+        items.evaluate(result.x, W, C);
+        result.profit = C;
+        result.weight = W;
+        result.stats.iterations = 1;
+        result.stats.improvements = 1;
+        result.stats.evaluations = 1;
+        result.stats.optimal = true;
+        if (options.onImprove)
+            options.onImprove({ 1, C, 0, 1 });
+    }
+    result.stats.seconds = budget.elapsed();
+    return result;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "solver.h"
+
+// Pisinger's exact minknap algorithm, the result is always optimal.
+// It has no budget, options other than the callbacks and the incumbent
+// are ignored. A better incumbent than minknap's own greedy solution
+// prunes more states from the start.
+class MinknapSolver : public Solver
+{
+public:
+    MinknapSolver() {}
+    // the incumbent is first searched for by warmStart, limited to
+    // warmIterations unless the options have an iteration limit
+    MinknapSolver(std::unique_ptr<Solver> warmStart, long long warmIterations);
+
+    const char* name() const override { return m_warmStart ? "minknap-warm" : "minknap"; }
+    SolverResult solve(const KnapsackInstance& items, int Cap, const SolverOptions& options) const override;
+
+private:
+    std::unique_ptr<Solver> m_warmStart;
+    long long m_warmIterations = 0;
+};
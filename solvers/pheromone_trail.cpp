@@ -0,0 +1,80 @@
+#include "pheromone_trail.h"
+
+DenseTrail::DenseTrail(int size, double base)
+    : m_base(base)
+    , m_pheromone(size, std::vector<double>(size, base))
+{
+}
+
+double DenseTrail::get(int i, int j) const
+{
+    return i < 0 ? m_base : m_pheromone[i][j] * m_scale;
+}
+
+void DenseTrail::deposit(int i, int j, double amount)
+{
+    if (i >= 0)
+        m_pheromone[i][j] += amount / m_scale;
+}
+
+void DenseTrail::rescale(double factor)
+{
+    for (auto& row : m_pheromone)
+        for (auto& p : row)
+            p *= factor;
+}
+
+
+ItemTrail::ItemTrail(int size, double base)
+    : m_pheromone(size, base)
+{
+}
+
+double ItemTrail::get(int, int j) const
+{
+    return m_pheromone[j] * m_scale;
+}
+
+void ItemTrail::deposit(int, int j, double amount)
+{
+    m_pheromone[j] += amount / m_scale;
+}
+
+void ItemTrail::rescale(double factor)
+{
+    for (auto& p : m_pheromone)
+        p *= factor;
+}
+
+
+SparseTrail::SparseTrail(int size, double base)
+    : m_size(size)
+    , m_base(base)
+    , m_untouched(base)
+{
+}
+
+double SparseTrail::get(int i, int j) const
+{
+    if (i < 0)
+        return m_base;
+
+    auto it = m_pheromone.find(key(i, j));
+    return (it == m_pheromone.end() ? m_untouched : it->second) * m_scale;
+}
+
+void SparseTrail::deposit(int i, int j, double amount)
+{
+    if (i < 0)
+        return;
+
+    auto it = m_pheromone.emplace(key(i, j), m_untouched).first;
+    it->second += amount / m_scale;
+}
+
+void SparseTrail::rescale(double factor)
+{
+    m_untouched *= factor;
+    for (auto& p : m_pheromone)
+        p.second *= factor;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+// pheromone left by the ants on the way from item i to item j,
+// i is -1 for the first item of the path
+//
+// Evaporation is lazy: the implementations store the pheromone divided by
+// the common scale factor, so evaporating is one multiplication of the scale.
+// When the scale gets too small the stored values are renormalized.
+class PheromoneTrail
+{
+public:
+    PheromoneTrail() : m_scale(1.0) {}
+    virtual ~PheromoneTrail() {}
+
+    virtual double get(int i, int j) const = 0;
+    virtual void deposit(int i, int j, double amount) = 0;
+
+    void evaporate(double evaporation)
+    {
+        m_scale *= evaporation;
+        if (m_scale < MinScale)
+        {
+            rescale(m_scale);
+            m_scale = 1.0;
+        }
+    }
+
+protected:
+    static constexpr double MinScale = 1e-100;
+
+    double m_scale;
+
+    // multiplies every stored value by the factor
+    virtual void rescale(double factor) = 0;
+};
+
+// N x N matrix, the first item of a path always sees the base pheromone
+class DenseTrail : public PheromoneTrail
+{
+    double m_base;
+    std::vector<std::vector<double>> m_pheromone;
+
+public:
+    DenseTrail(int size, double base);
+
+    double get(int i, int j) const override;
+    void deposit(int i, int j, double amount) override;
+
+protected:
+    void rescale(double factor) override;
+};
+
+// one trail per item, the edge (i, j) gets the trail of j whatever i is
+class ItemTrail : public PheromoneTrail
+{
+    std::vector<double> m_pheromone;
+
+public:
+    ItemTrail(int size, double base);
+
+    double get(int i, int j) const override;
+    void deposit(int i, int j, double amount) override;
+
+protected:
+    void rescale(double factor) override;
+};
+
+// only the edges the ants have walked are stored,
+// all the others share one value which evaporates like the stored ones
+class SparseTrail : public PheromoneTrail
+{
+    int64_t m_size;
+    double m_base;
+    double m_untouched;
+    std::unordered_map<int64_t, double> m_pheromone;
+
+    int64_t key(int i, int j) const { return int64_t(i) * m_size + j; }
+
+public:
+    SparseTrail(int size, double base);
+
+    double get(int i, int j) const override;
+    void deposit(int i, int j, double amount) override;
+
+protected:
+    void rescale(double factor) override;
+};
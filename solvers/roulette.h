@@ -0,0 +1,138 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+// Roulette wheel over items with fixed non-negative weights.
+// Prefix sums are kept in a Fenwick tree, so both sampling and
+// removing an item from the wheel are O(log N).
+class Roulette
+{
+    std::vector<double> m_tree;
+    // the same for the number of active items, which is exact
+    std::vector<int> m_count;
+    std::vector<double> m_weight;
+    int m_active;
+    int m_top;
+
+    template <class T>
+    static void add(std::vector<T>& tree, int i, T delta)
+    {
+        for (++i; i < int(tree.size()); i += i & -i)
+            tree[i] += delta;
+    }
+
+    void rebuild()
+    {
+        const int n = int(m_weight.size());
+        m_tree.assign(n + 1, 0.0);
+        m_count.assign(n + 1, 0);
+        m_active = 0;
+        for (int i = 0; i < n; ++i)
+        {
+            m_tree[i + 1] += m_weight[i];
+            m_count[i + 1] += m_weight[i] > 0.0;
+            const int parent = (i + 1) + ((i + 1) & -(i + 1));
+            if (parent <= n)
+            {
+                m_tree[parent] += m_tree[i + 1];
+                m_count[parent] += m_count[i + 1];
+            }
+            if (m_weight[i] > 0.0)
+                ++m_active;
+        }
+    }
+
+    // the k-th active item, k from 1
+    int findActive(int k) const
+    {
+        const int n = int(m_weight.size());
+        int pos = 0;
+        for (int step = m_top; step > 0; step /= 2)
+        {
+            if (pos + step <= n && m_count[pos + step] < k)
+            {
+                pos += step;
+                k -= m_count[pos];
+            }
+        }
+        return pos;
+    }
+
+    // number of active items before item i
+    int activeBefore(int i) const
+    {
+        int count = 0;
+        for (; i > 0; i -= i & -i)
+            count += m_count[i];
+        return count;
+    }
+
+public:
+    Roulette() : m_active(0), m_top(0) {}
+
+    void build(const std::vector<double>& weights)
+    {
+        const int n = int(weights.size());
+        m_weight = weights;
+        rebuild();
+
+        m_top = 1;
+        while (m_top * 2 <= n)
+            m_top *= 2;
+    }
+
+    bool empty() const { return m_active == 0; }
+
+    double total() const
+    {
+        double sum = 0.0;
+        for (int i = int(m_tree.size()) - 1; i > 0; i -= i & -i)
+            sum += m_tree[i];
+        return sum;
+    }
+
+    void remove(int i)
+    {
+        if (m_weight[i] > 0.0)
+        {
+            add(m_tree, i, -m_weight[i]);
+            add(m_count, i, -1);
+            m_weight[i] = 0.0;
+            --m_active;
+
+            // the rounding errors of the subtractions outweigh the items left
+            if (m_active > 0 && total() <= 0.0)
+                rebuild();
+        }
+    }
+
+    // the item where the cumulative weight passes r, r in [0, total());
+    // -1 if the wheel is empty
+    int sample(double r) const
+    {
+        if (m_active == 0)
+            return -1;
+
+        // a generator may return the upper bound itself
+        r = std::max(0.0, std::min(r, std::nextafter(total(), 0.0)));
+
+        const int n = int(m_weight.size());
+        int pos = 0;
+        for (int step = m_top; step > 0; step /= 2)
+        {
+            if (pos + step <= n && m_tree[pos + step] <= r)
+            {
+                pos += step;
+                r -= m_tree[pos];
+            }
+        }
+        if (pos < n && m_weight[pos] > 0.0)
+            return pos;
+
+        // rounding may land on a removed item, take the next active one,
+        // or the last one at the end of the wheel
+        return findActive(std::min(activeBefore(pos) + 1, m_active));
+    }
+};
@@ -0,0 +1,39 @@
+#include "solver.h"
+#include "hill_climbing.h"
+#include "tabu_search.h"
+#include "ant_colony_solver.h"
+#include "minknap_solver.h"
+#include "core_reduction.h"
+
+std::unique_ptr<Solver> createSolver(const std::string& name)
+{
+    const std::string suffix = "-core";
+    if (name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0)
+    {
+        std::unique_ptr<Solver> solver = createSolver(name.substr(0, name.size() - suffix.size()));
+        return solver ? std::make_unique<CoreSolver>(std::move(solver)) : nullptr;
+    }
+    if (name == "hc")
+        return std::make_unique<HillClimbingSolver>();
+    if (name == "hc-vnd")
+        return std::make_unique<HillClimbingSolver>(10000, HillClimbingSolver::Neighbourhoods::Descent);
+    if (name == "hc-repair")
+        return std::make_unique<HillClimbingSolver>(10000, HillClimbingSolver::Neighbourhoods::RandomFlips, true);
+    if (name == "ts")
+        return std::make_unique<TabuSearchSolver>();
+    if (name == "ts-repair")
+        return std::make_unique<TabuSearchSolver>(true);
+    if (name == "aco")
+        return std::make_unique<AntColonySolver>();
+    if (name == "minknap")
+        return std::make_unique<MinknapSolver>();
+    // a short tabu search finds the incumbent minknap starts from
+    if (name == "minknap-warm")
+        return std::make_unique<MinknapSolver>(std::make_unique<TabuSearchSolver>(true), 100);
+    return nullptr;
+}
+
+std::vector<std::string> solverNames()
+{
+    return { "hc", "hc-vnd", "hc-repair", "ts", "ts-repair", "aco", "minknap", "minknap-warm" };
+}
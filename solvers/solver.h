@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../common/knapsack_instance.h"
+
+// progress of a running solver
+struct SolverEvent
+{
+    // moves made so far, 0 for the initial solution
+    long long iteration;
+    long long profit;
+    // walker or thread which reported the event
+    int worker;
+    // neighbours or solutions evaluated so far by the worker
+    long long evaluations;
+};
+
+// callbacks may be invoked concurrently from the solver's own threads
+using SolverCallback = std::function<void(const SolverEvent&)>;
+
+struct SolverResult;
+
+struct SolverOptions
+{
+    // wall clock budget in seconds, 0 for none
+    double timeLimit = 0;
+    // iteration budget in the solver's own units, 0 for its default
+    long long iterationLimit = 0;
+    // random sequences are derived from (seed, stream), so repeated runs
+    // with the same seed and different streams are independent
+    unsigned long long seed = 0;
+    unsigned long long stream = 0;
+    int numThreads = 1;
+    // a bound on the profit such as dantzigBound(), a solution which
+    // reaches it is optimal and the search stops there; -1 for none
+    long long upperBound = -1;
+    // a known solution of the instance; minknap starts its search from it
+    // and the core reduction fixes items against it, others ignore it
+    const SolverResult* incumbent = nullptr;
+
+    // a better solution was found
+    SolverCallback onImprove;
+    // the current solution changed, called on every move
+    SolverCallback onStep;
+};
+
+struct SolverStats
+{
+    long long iterations = 0;
+    long long improvements = 0;
+    long long evaluations = 0;
+    double seconds = 0;
+    // items left free by the core reduction, 0 when it isn't used
+    long long coreSize = 0;
+    // the solution is proven optimal
+    bool optimal = false;
+};
+
+struct SolverResult
+{
+    Bitset x;
+    long long profit = 0;
+    long long weight = 0;
+    SolverStats stats;
+};
+
+// a knapsack algorithm which works on an instance held in memory;
+// solve() doesn't modify the solver, so one object may be shared by threads
+class Solver
+{
+public:
+    virtual ~Solver() {}
+    virtual const char* name() const = 0;
+    virtual SolverResult solve(const KnapsackInstance& items, int Cap, const SolverOptions& options) const = 0;
+};
+
+// one of solverNames() with its default parameters, nullptr for other names;
+// a name ending in "-core" runs that solver on the core of the instance
+std::unique_ptr<Solver> createSolver(const std::string& name);
+std::vector<std::string> solverNames();
+
+// time, iteration and profit limits of a SolverOptions
+class SolverBudget
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    SolverBudget(const SolverOptions& options, long long defaultIterations)
+        : m_start(Clock::now())
+        , m_timeLimit(options.timeLimit)
+        , m_iterationLimit(options.iterationLimit > 0 ? options.iterationLimit : defaultIterations)
+        , m_upperBound(options.upperBound)
+        , m_optimal(false)
+    {
+    }
+
+    long long iterationLimit() const { return m_iterationLimit; }
+    double elapsed() const { return std::chrono::duration<double>(Clock::now() - m_start).count(); }
+
+    // the clock is only read every 256 iterations
+    bool exhausted(long long iteration) const
+    {
+        if (optimal())
+            return true;
+        if (m_iterationLimit > 0 && iteration >= m_iterationLimit)
+            return true;
+        return m_timeLimit > 0 && (iteration & 255) == 0 && elapsed() >= m_timeLimit;
+    }
+
+    bool timeIsUp() const { return m_timeLimit > 0 && elapsed() >= m_timeLimit; }
+
+    // called with the profit of every new best solution, from any thread;
+    // once one reaches the upper bound every user of the budget is exhausted
+    bool reached(long long profit) const
+    {
+        if (m_upperBound >= 0 && profit >= m_upperBound)
+            m_optimal.store(true, std::memory_order_relaxed);
+        return optimal();
+    }
+
+    bool optimal() const { return m_optimal.load(std::memory_order_relaxed); }
+
+private:
+    Clock::time_point m_start;
+    double m_timeLimit;
+    long long m_iterationLimit;
+    long long m_upperBound;
+    mutable std::atomic<bool> m_optimal;
+};
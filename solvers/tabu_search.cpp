@@ -0,0 +1,368 @@
+#include "tabu_search.h"
+#include "flip_scan.h"
+#include "elite_pool.h"
+#include "greedy_repair.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using Items = KnapsackInstance;
+    // items flipped by one move
+    using Diff = std::vector<int>;
+    using Rng = std::mt19937_64;
+
+    
+    class State
+    {
+    private:
+        int m_Cap;
+        const Items* m_items;
+        Bitset m_x;
+
+        // current cost
+        int m_C;
+        // cutrrent weight
+        int m_W;
+
+    public:
+        State(const Items& items, int Cap, Rng& rng )
+            : m_Cap(Cap)
+            , m_items(&items)
+            , m_x(items.size())
+            , m_C(0)
+            , m_W(0) 
+        {
+            // init random state
+            const Items& it = *m_items;
+            std::uniform_int_distribution<int> pick(0, int(it.size()) - 1);
+            for (int i = 0; i < int(it.size()); ++i)
+            {
+                int j = pick(rng);
+                if (!m_x.test(j) && m_W + it.w[j] <= m_Cap)
+                {
+                    m_x.set(j);
+                    m_W += it.w[j];
+                    m_C += it.c[j];
+                }
+            }
+        }
+
+        State(const Items& items, int Cap, const Bitset& x)
+            : m_Cap(Cap)
+            , m_items(&items)
+            , m_x(x)
+            , m_C(0)
+            , m_W(0)
+        {
+            evaluate();
+        }
+
+        int getCost() const { return m_C; }
+        int getWeight() const { return m_W; }
+        const Bitset& getSolution() const { return m_x; }
+
+        void evaluate()
+        {
+            long long W = 0;
+            long long C = 0;
+            m_items->evaluate(m_x, W, C);
+            m_W = int(W);
+            m_C = int(C);
+        }
+
+        void flip(int i)
+        {
+            const Items& it = *m_items;
+            bool flip = !m_x.test(i);
+            if (flip)
+            {
+                m_C += it.c[i];
+                m_W += it.w[i];
+            }
+            else
+            {
+                m_C -= it.c[i];
+                m_W -= it.w[i];
+            }
+            m_x.assign(i, flip);
+        }
+
+        // drops up to numDrops random items, the state stays feasible
+        void perturb(Rng& rng, int numDrops)
+        {
+            const Items& it = *m_items;
+            std::uniform_int_distribution<int> pick(0, int(it.size()) - 1);
+            for (int k = 0; k < numDrops; ++k)
+            {
+                int j = pick(rng);
+                if (m_x.test(j))
+                {
+                    m_x.reset(j);
+                    m_C -= it.c[j];
+                    m_W -= it.w[j];
+                }
+            }
+        }
+    };
+
+    using Storage = std::vector<int>;
+    class Memory
+    {
+        // tabu tenure
+        int m_tabTenureDuration;
+        // number of moves made so far
+        int m_clock;
+        // the move number until which the item stays tabu
+        Storage m_shortMemory;
+        Storage m_longMemory;
+    public:
+        Memory(int size, int tabTenureDuration )
+            : m_tabTenureDuration(tabTenureDuration)
+            , m_clock(0)
+        {
+            m_shortMemory.resize(size, 0);
+            m_longMemory.resize(size, 0);
+        }
+
+        void reset()
+        {
+            // moving the clock past the tenure expires every tabu at once
+            m_clock += m_tabTenureDuration;
+            std::fill(m_longMemory.begin(), m_longMemory.end(), 0);
+        }
+
+        // the flipped items stay tabu for the next m_tabTenureDuration moves
+        void updateTabu(const Diff& flipped)
+        {
+            ++m_clock;
+            for (auto& i : flipped)
+            {
+                m_shortMemory[i] = m_clock + m_tabTenureDuration;
+            }
+        }
+
+        // item i is tabu while getShortMemory()[i] > getClock()
+        const int* getShortMemory() const { return m_shortMemory.data(); }
+        int getClock() const { return m_clock; }
+        const int* getLongMemory() const { return m_longMemory.data(); }
+
+        void updateLongMemory(const Diff& flipped)
+        {
+            for (auto& i : flipped)
+            {
+                ++m_longMemory[i];
+            }
+        }
+    };
+
+    const long long MaxIterations = 10000000;
+
+    // fills the state with the best ratio items which fit and are allowed,
+    // the added items are appended to diff
+    template <class Allowed>
+    void fill(State& x, GreedyRepair& repair, int Cap, Allowed allowed, Diff& diff)
+    {
+        long long W = x.getWeight();
+        long long C = x.getCost();
+        repair.repair(W, C, Cap, allowed, [&](int i)
+            {
+                x.flip(i);
+                diff.push_back(i);
+            });
+    }
+
+    // pool and walker are set when the search runs as one of several concurrent walkers:
+    // its best state is published every PublishPeriod moves, and on stagnation
+    // the walker restarts from a perturbed elite instead of resetting in place
+    void tabusearch(const Items& itemsList, int Cap, const SolverOptions& options, const SolverBudget& budget,
+        bool repairMoves, Rng& rng, SolverResult& result, ElitePool* pool = nullptr, int walker = 0)
+    {
+        const int Numresets = 7;
+        const int PublishPeriod = 100;
+
+        // This is the most affecting parameter on presicion
+        // ythe less the value - the more time is needed to escape local optimas, 
+        // but the more precision we have in the end
+        const double alpha = 0.7;
+        const int N = itemsList.size();
+
+        State x(itemsList, Cap, rng);
+
+        Memory memory(N, 5);
+        auto notTabu = [&](int i) { return memory.getShortMemory()[i] <= memory.getClock(); };
+
+        // the ratio repair tops the state up after every move
+        std::unique_ptr<GreedyRepair> repair;
+        if (repairMoves)
+        {
+            repair = std::make_unique<GreedyRepair>(itemsList, x.getSolution());
+            Diff added;
+            fill(x, *repair, Cap, notTabu, added);
+        }
+
+        if (options.onImprove)
+            options.onImprove({ 0, x.getCost(), walker, 0 });
+        budget.reached(x.getCost());
+
+        State best = x;
+
+        int numResets = 0;
+        long long iteration = 0;
+        bool published = false;
+        // the items flipped by the current move, reused by every iteration
+        Diff flipped;
+        flipped.reserve(N);
+
+        for( ; !budget.exhausted(iteration); ++iteration )
+        {
+            // evaluate the whole 1-flip neighbourhood at once
+            FlipScanInput scan;
+            scan.c = itemsList.c.data();
+            scan.w = itemsList.w.data();
+            scan.x = x.getSolution().data();
+            scan.tabu = memory.getShortMemory();
+            scan.longMemory = memory.getLongMemory();
+            scan.n = N;
+            scan.C = x.getCost();
+            scan.W = x.getWeight();
+            scan.Cap = Cap;
+            scan.now = memory.getClock();
+            scan.bestCost = best.getCost();
+            scan.alpha = alpha;
+
+            FlipScanResult move = scanFlips(scan);
+
+            if (move.index < 0)
+            {
+                if (numResets > Numresets - 1)
+                {
+                    // looks like we've found the optimum
+                    break;
+                }
+                else
+                {
+                    if (pool != nullptr)
+                    {
+                        if (!published)
+                        {
+                            pool->publish(walker, best.getSolution(), best.getCost(), best.getWeight());
+                            published = true;
+                        }
+
+                        Bitset elite;
+                        int eliteCost = 0;
+                        int eliteWeight = 0;
+                        if (pool->fetchRandom(rng, elite, eliteCost, eliteWeight))
+                        {
+                            x = State(itemsList, Cap, elite);
+                            x.perturb(rng, std::max(1, N / 50));
+                            if (repair)
+                                repair->reset(x.getSolution());
+                        }
+                    }
+                    memory.reset();
+                    numResets++;
+                    continue;
+                }
+            }
+
+            flipped.clear();
+            flipped.push_back(move.index);
+            x.flip(move.index);
+            if (repair)
+            {
+                // the dropped item isn't tabu yet, but mustn't come straight back
+                repair->flip(move.index);
+                fill(x, *repair, Cap, [&](int i) { return i != move.index && notTabu(i); }, flipped);
+            }
+
+            if (options.onStep)
+                options.onStep({ iteration + 1, x.getCost(), walker, (iteration + 1) * N });
+
+            if (x.getCost() > best.getCost())
+            {
+                best = x;
+                published = false;
+                ++result.stats.improvements;
+                if (options.onImprove)
+                    options.onImprove({ iteration + 1, best.getCost(), walker, (iteration + 1) * N });
+                budget.reached(best.getCost());
+            }
+
+            if (pool != nullptr && !published && iteration % PublishPeriod == 0)
+            {
+                pool->publish(walker, best.getSolution(), best.getCost(), best.getWeight());
+                published = true;
+            }
+            
+            memory.updateTabu(flipped);
+            memory.updateLongMemory(flipped);
+        }
+
+        if (pool != nullptr && !published)
+            pool->publish(walker, best.getSolution(), best.getCost(), best.getWeight());
+
+        result.x = best.getSolution();
+        result.profit = best.getCost();
+        result.weight = best.getWeight();
+        result.stats.iterations = iteration;
+        // every iteration scans the whole 1-flip neighbourhood
+        result.stats.evaluations = iteration * N;
+    }
+}
+
+SolverResult TabuSearchSolver::solve(const KnapsackInstance& items, int Cap, const SolverOptions& options) const
+{
+    SolverBudget budget(options, MaxIterations);
+    const int numWalkers = std::max(1, options.numThreads);
+
+    SolverResult result;
+    if (numWalkers == 1)
+    {
+        std::seed_seq seq{ options.seed, options.stream };
+        Rng rng(seq);
+        tabusearch(items, Cap, options, budget, m_repair, rng, result);
+        result.stats.optimal = budget.optimal();
+        result.stats.seconds = budget.elapsed();
+        return result;
+    }
+
+    // runs numWalkers tabu searches concurrently on the same instance,
+    // the walkers exchange their best states through the elite pool
+    ElitePool pool(numWalkers, items.size());
+    std::vector<SolverResult> walkerResults(numWalkers);
+
+    std::vector<std::thread> walkers;
+    for (int w = 0; w < numWalkers; ++w)
+    {
+        walkers.emplace_back([&, w]()
+            {
+                std::seed_seq seq{ options.seed, options.stream, (unsigned long long)w };
+                Rng rng(seq);
+                tabusearch(items, Cap, options, budget, m_repair, rng, walkerResults[w], &pool, w);
+            });
+    }
+    for (auto& t : walkers)
+        t.join();
+
+    for (auto& r : walkerResults)
+    {
+        result.stats.iterations += r.stats.iterations;
+        result.stats.improvements += r.stats.improvements;
+        result.stats.evaluations += r.stats.evaluations;
+        if (r.profit > result.profit || result.x.size() == 0)
+        {
+            result.x = std::move(r.x);
+            result.profit = r.profit;
+            result.weight = r.weight;
+        }
+    }
+    result.stats.optimal = budget.optimal();
+    result.stats.seconds = budget.elapsed();
+    return result;
+}
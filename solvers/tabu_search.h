@@ -0,0 +1,21 @@
+#pragma once
+
+#include "solver.h"
+
+// tabu search over the 1-flip neighbourhood with a long term memory penalty.
+// With more than one thread every thread runs its own walker, the walkers
+// exchange their best states through an elite pool and restart from them.
+// With repair the state is filled up with the best ratio items which fit
+// and aren't tabu after every move, see greedy_repair.h
+class TabuSearchSolver : public Solver
+{
+public:
+    explicit TabuSearchSolver(bool repair = false) : m_repair(repair) {}
+
+    const char* name() const override { return m_repair ? "ts-repair" : "ts"; }
+    // options.iterationLimit is the number of moves of every walker
+    SolverResult solve(const KnapsackInstance& items, int Cap, const SolverOptions& options) const override;
+
+private:
+    bool m_repair;
+};